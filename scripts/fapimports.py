@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+
+import os
+import struct
+from dataclasses import dataclass, fields
+
+from fbt.elfimports import ElfRelocatableFile
+from fbt.elfmanifest import ElfManifestImportTable
+from fbt.sdk.cache import SdkCache
+from fbt.sdk.hashes import gnu_sym_hash
+from flipper.app import App
+
+
+class ApiHashTable:
+    """Host model of firmware API table, sorted by gnu_sym_hash"""
+
+    def __init__(self, names):
+        self.hashes = sorted(gnu_sym_hash(name) for name in names)
+        self.comparisons = 0
+
+    def resolve(self, name_hash: int) -> bool:
+        # Same binary search firmware does, counting probes
+        low, high = 0, len(self.hashes)
+        while low < high:
+            self.comparisons += 1
+            middle = (low + high) // 2
+            if self.hashes[middle] < name_hash:
+                low = middle + 1
+            else:
+                high = middle
+        return low < len(self.hashes) and self.hashes[low] == name_hash
+
+
+@dataclass
+class LoaderWork:
+    imports: int = 0
+    sites: int = 0
+    unresolved: int = 0
+    storage_bytes: int = 0
+    symbol_reads: int = 0
+    hashed_chars: int = 0
+    api_comparisons: int = 0
+    cache_lookups: int = 0
+
+    def __add__(self, other: "LoaderWork") -> "LoaderWork":
+        return LoaderWork(
+            *(getattr(self, f.name) + getattr(other, f.name) for f in fields(self))
+        )
+
+
+class LoaderSimulator:
+    """Counts resolution work of both manifest formats for one app"""
+
+    REL_ENTRY_SIZE = 8
+    SYMBOL_ENTRY_SIZE = 16
+    # Base header + ElfManifestV1
+    MANIFEST_V1_SIZE = struct.calcsize("<IIIh") + struct.calcsize("<hI32s?32s")
+
+    def __init__(self, api: ApiHashTable, fap_path: str):
+        self.api = api
+        self.elf = ElfRelocatableFile.from_file(fap_path)
+        self.imports = self.elf.imports()
+
+    def embedded_table(self) -> ElfManifestImportTable | None:
+        if not (fapmeta := self.elf.section_by_name(".fapmeta")):
+            return None
+        data = self.elf.section_data(fapmeta)
+        _, manifest_version = struct.unpack_from("<II", data)
+        if manifest_version < 2:
+            return None
+        return ElfManifestImportTable.from_bytes(data[self.MANIFEST_V1_SIZE :])
+
+    def simulate_v1(self) -> LoaderWork:
+        """Per relocation: read symbol entry, resolve name on cache miss"""
+        work = LoaderWork(imports=len(self.imports))
+        comparisons = self.api.comparisons
+        for entry in self.imports:
+            work.sites += entry.site_count
+            work.symbol_reads += entry.site_count
+            work.cache_lookups += entry.site_count
+            # First site misses relocation cache: read name, hash it, search API
+            work.storage_bytes += len(entry.name) + 1
+            work.hashed_chars += len(entry.name)
+            work.unresolved += not self.api.resolve(entry.name_hash)
+        work.storage_bytes += work.sites * (
+            self.REL_ENTRY_SIZE + self.SYMBOL_ENTRY_SIZE
+        )
+        work.api_comparisons = self.api.comparisons - comparisons
+        return work
+
+    def simulate_v2(self, table: ElfManifestImportTable) -> LoaderWork:
+        """Per symbol: one search by precomputed hash, then patch all sites"""
+        work = LoaderWork(imports=len(table.imports))
+        work.storage_bytes = len(table.as_bytes())
+        comparisons = self.api.comparisons
+        for entry in table.imports:
+            work.sites += entry.site_count
+            work.unresolved += not self.api.resolve(entry.name_hash)
+        work.api_comparisons = self.api.comparisons - comparisons
+        return work
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_table = self.subparsers.add_parser(
+            "table", help="Show import table of app ELF"
+        )
+        self.parser_table.add_argument("elf", help="App ELF or .fap")
+        self.parser_table.set_defaults(func=self.table)
+
+        self.parser_simulate = self.subparsers.add_parser(
+            "simulate", help="Compare loader resolution work for v1 and v2 manifests"
+        )
+        self.parser_simulate.add_argument(
+            "--api", help="SDK api_symbols.csv", required=True
+        )
+        self.parser_simulate.add_argument("faps", nargs="+", help="App ELFs or .faps")
+        self.parser_simulate.set_defaults(func=self.simulate)
+
+    def table(self):
+        elf = ElfRelocatableFile.from_file(self.args.elf)
+        imports = elf.imports()
+        section_names = {gnu_sym_hash(s.name): s.name for s in elf.sections}
+        for entry in imports:
+            groups = ", ".join(
+                f"{section_names[section_hash]}:{len(sites)}"
+                for section_hash, sites in sorted(entry.sites.items())
+            )
+            print(f"0x{entry.name_hash:08x} {entry.name:<40} {groups}")
+        sites = sum(entry.site_count for entry in imports)
+        table_size = len(ElfManifestImportTable(imports).as_bytes())
+        self.logger.info(
+            f"{len(imports)} symbols, {sites} sites, table is {table_size} bytes"
+        )
+        return 0
+
+    def _print_row(self, label: str, work: LoaderWork):
+        print(
+            f"{label:<32} {work.imports:>7} {work.sites:>7} {work.storage_bytes:>9} "
+            f"{work.symbol_reads:>8} {work.hashed_chars:>8} {work.api_comparisons:>8} "
+            f"{work.cache_lookups:>8} {work.unresolved:>6}"
+        )
+
+    def simulate(self):
+        api = ApiHashTable(SdkCache(self.args.api).get_valid_names())
+        self.logger.info(f"API table: {len(api.hashes)} symbols")
+
+        print(
+            f"{'app':<32} {'imports':>7} {'sites':>7} {'io bytes':>9} "
+            f"{'symreads':>8} {'hashed':>8} {'compares':>8} {'cache':>8} {'unres':>6}"
+        )
+        total_v1, total_v2 = LoaderWork(), LoaderWork()
+        for fap in self.args.faps:
+            simulator = LoaderSimulator(api, fap)
+            computed = ElfManifestImportTable(simulator.imports)
+            if (embedded := simulator.embedded_table()) is None:
+                embedded = computed
+            elif embedded.as_bytes() != computed.as_bytes():
+                self.logger.error(f"{fap}: embedded import table is stale")
+                return 1
+
+            work_v1, work_v2 = simulator.simulate_v1(), simulator.simulate_v2(embedded)
+            total_v1 += work_v1
+            total_v2 += work_v2
+            name = os.path.basename(fap)[:28]
+            self._print_row(f"{name} v1", work_v1)
+            self._print_row(f"{name} v2", work_v2)
+
+        self._print_row("total v1", total_v1)
+        self._print_row("total v2", total_v2)
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
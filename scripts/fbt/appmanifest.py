@@ -28,6 +28,7 @@ class FlipperAppType(Enum):
     MENUEXTERNAL = "MenuExternal"
     METAPACKAGE = "Package"
     PLUGIN = "Plugin"
+    BENCHMARK = "Benchmark"
 
 
 @dataclass
@@ -114,7 +115,10 @@ class FlipperApplication:
 
     @property
     def is_default_deployable(self):
-        return self.apptype != FlipperAppType.DEBUG and self.fap_category != "Examples"
+        return (
+            self.apptype not in (FlipperAppType.DEBUG, FlipperAppType.BENCHMARK)
+            and self.fap_category != "Examples"
+        )
 
     @property
     def do_strict_import_checks(self):
@@ -157,6 +161,16 @@ class AppManager:
                 return app
         return None
 
+    def get_benchmarks(self):
+        """Benchmark apps of all loaded manifests, target filtered on load"""
+        return sorted(
+            filter(
+                lambda app: app.apptype == FlipperAppType.BENCHMARK,
+                self.known_apps.values(),
+            ),
+            key=lambda app: app.appid,
+        )
+
     def _validate_app_params(self, *args, **kw):
         apptype = kw.get("apptype")
         if apptype == FlipperAppType.PLUGIN:
@@ -174,6 +188,11 @@ class AppManager:
                     f"App {kw.get('appid')} cannot have fal_embedded set"
                 )
 
+        if apptype == FlipperAppType.BENCHMARK and not kw.get("entry_point"):
+            raise FlipperManifestException(
+                f"Benchmark {kw.get('appid')} must have 'entry_point' in manifest"
+            )
+
         if apptype in AppBuildset.dist_app_types:
             # For distributing .fap's resources, there's "fap_file_assets"
             for app_property in ("resources",):
@@ -284,6 +303,7 @@ class AppBuildset:
         FlipperAppType.PLUGIN: True,
         FlipperAppType.DEBUG: True,
         FlipperAppType.MENUEXTERNAL: False,
+        FlipperAppType.BENCHMARK: False,
     }
 
     @classmethod
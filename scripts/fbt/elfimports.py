@@ -0,0 +1,148 @@
+import struct
+from collections import defaultdict
+from dataclasses import dataclass, field
+from typing import Optional
+
+from .sdk.hashes import gnu_sym_hash
+
+
+class ElfFormatError(Exception):
+    pass
+
+
+@dataclass
+class ElfSection:
+    index: int
+    name: str
+    type: int
+    flags: int
+    offset: int
+    size: int
+    link: int
+    info: int
+    entsize: int
+
+
+@dataclass
+class ElfRelocation:
+    section_index: int
+    offset: int
+    type: int
+    symbol_index: int
+
+
+@dataclass
+class ElfImport:
+    name: str
+    name_hash: int
+    # gnu_sym_hash of target section name -> [(offset, relocation type)].
+    # Names, unlike indices, survive section removal and reordering by
+    # strip or objcopy after the table is built.
+    sites: dict[int, list[tuple[int, int]]] = field(
+        default_factory=lambda: defaultdict(list)
+    )
+
+    @property
+    def site_count(self) -> int:
+        return sum(len(sites) for sites in self.sites.values())
+
+
+class ElfRelocatableFile:
+    """Minimal reader for 32-bit little-endian relocatable ELF (.fap)
+
+    ARM uses REL relocations with addends stored in place, so site offset
+    and relocation type is all the loader needs to patch.
+    """
+
+    SHT_SYMTAB = 2
+    SHT_REL = 9
+    SHF_ALLOC = 0x2
+    SHN_UNDEF = 0
+
+    HEADER_FORMAT = "<16xHHIIIIIHHHHHH"
+    SECTION_FORMAT = "<IIIIIIIIII"
+    SYMBOL_FORMAT = "<IIIBBH"
+
+    def __init__(self, data: bytes):
+        self.data = data
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ElfFormatError("Not a 32-bit little-endian ELF file")
+        (*_, section_offset, _, _, _, _, section_size, section_count, names_index) = (
+            struct.unpack_from(self.HEADER_FORMAT, data)
+        )
+
+        self.sections: list[ElfSection] = []
+        for index in range(section_count):
+            name, sh_type, flags, _, offset, size, link, info, _, entsize = (
+                struct.unpack_from(
+                    self.SECTION_FORMAT, data, section_offset + index * section_size
+                )
+            )
+            self.sections.append(
+                ElfSection(
+                    index, name, sh_type, flags, offset, size, link, info, entsize
+                )
+            )
+        names = self.sections[names_index]
+        for section in self.sections:
+            section.name = self.string_at(names, section.name)
+
+    @classmethod
+    def from_file(cls, path: str) -> "ElfRelocatableFile":
+        with open(path, "rb") as f:
+            return cls(f.read())
+
+    def section_data(self, section: ElfSection) -> bytes:
+        return self.data[section.offset : section.offset + section.size]
+
+    def section_by_name(self, name: str) -> Optional[ElfSection]:
+        return next((s for s in self.sections if s.name == name), None)
+
+    def string_at(self, string_table: ElfSection, offset: int) -> str:
+        start = string_table.offset + offset
+        return self.data[start : self.data.index(b"\x00", start)].decode("utf-8")
+
+    def symbols(self) -> list[tuple[str, int]]:
+        """(name, section index) for each symbol table entry"""
+        symtab = next(s for s in self.sections if s.type == self.SHT_SYMTAB)
+        strtab = self.sections[symtab.link]
+        return [
+            (self.string_at(strtab, name), shndx)
+            for name, _, _, _, _, shndx in struct.iter_unpack(
+                self.SYMBOL_FORMAT, self.section_data(symtab)
+            )
+        ]
+
+    def relocation_sections(self) -> list[ElfSection]:
+        # Only relocations of loaded sections matter, debug info is not patched
+        return [
+            section
+            for section in self.sections
+            if section.type == self.SHT_REL
+            and self.sections[section.info].flags & self.SHF_ALLOC
+        ]
+
+    def relocations(self, section: ElfSection) -> list[ElfRelocation]:
+        return [
+            ElfRelocation(section.info, offset, info & 0xFF, info >> 8)
+            for offset, info in struct.iter_unpack("<II", self.section_data(section))
+        ]
+
+    def imports(self) -> list[ElfImport]:
+        """Relocation sites of undefined symbols, sorted by name hash"""
+        symbols = self.symbols()
+        imports: dict[str, ElfImport] = {}
+        for section in self.relocation_sections():
+            for relocation in self.relocations(section):
+                name, shndx = symbols[relocation.symbol_index]
+                if shndx != self.SHN_UNDEF or not name:
+                    continue
+                if name not in imports:
+                    imports[name] = ElfImport(name, gnu_sym_hash(name))
+                section_hash = gnu_sym_hash(
+                    self.sections[relocation.section_index].name
+                )
+                imports[name].sites[section_hash].append(
+                    (relocation.offset, relocation.type)
+                )
+        return sorted(imports.values(), key=lambda entry: entry.name_hash)
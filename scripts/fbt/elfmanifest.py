@@ -1,10 +1,12 @@
 import os
 import struct
 from dataclasses import dataclass, field
+from typing import Optional
 
 from flipper.assets.icon import file2image
 
 from .appmanifest import FlipperApplication
+from .elfimports import ElfImport, ElfRelocatableFile
 
 _MANIFEST_MAGIC = 0x52474448
 
@@ -45,10 +47,81 @@ class ElfManifestV1:
         )
 
 
+@dataclass
+class ElfManifestImportTable:
+    """
+    Precomputed imports, so loader resolves each API symbol once
+    u16 symbol_count
+    Symbols, sorted by name_hash:
+      u32 name_hash
+      u16 group_count
+      Groups:
+        u32 section_name_hash: gnu_sym_hash of target section name
+        u16 site_count
+        u32[] sites: (offset << 8) | relocation type
+    Relocations of undefined symbols in .rel sections are covered by the
+    table and must be skipped by the loader. Sections are referenced by
+    name and site offsets are section-relative, so the table stays valid
+    when later objcopy steps renumber sections.
+    """
+
+    imports: list[ElfImport] = field(default_factory=list)
+
+    SITE_OFFSET_LIMIT = 1 << 24
+
+    def as_bytes(self):
+        data = struct.pack("<H", len(self.imports))
+        for entry in self.imports:
+            data += struct.pack("<IH", entry.name_hash, len(entry.sites))
+            for section_hash, sites in sorted(entry.sites.items()):
+                data += struct.pack("<IH", section_hash, len(sites))
+                if max(offset for offset, _ in sites) >= self.SITE_OFFSET_LIMIT:
+                    raise ValueError(
+                        f"Relocation offset of {entry.name} is out of range"
+                    )
+                data += struct.pack(
+                    f"<{len(sites)}I",
+                    *(
+                        (offset << 8) | relocation_type
+                        for offset, relocation_type in sites
+                    ),
+                )
+        return data
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> "ElfManifestImportTable":
+        (symbol_count,) = struct.unpack_from("<H", data)
+        position = 2
+        imports = []
+        for _ in range(symbol_count):
+            name_hash, group_count = struct.unpack_from("<IH", data, position)
+            position += 6
+            entry = ElfImport("", name_hash)
+            for _ in range(group_count):
+                section_hash, site_count = struct.unpack_from("<IH", data, position)
+                position += 6
+                entry.sites[section_hash] = [
+                    (site >> 8, site & 0xFF)
+                    for site in struct.unpack_from(f"<{site_count}I", data, position)
+                ]
+                position += 4 * site_count
+            imports.append(entry)
+        return cls(imports)
+
+
+@dataclass
+class ElfManifestV2(ElfManifestV1):
+    import_table: ElfManifestImportTable = field(default_factory=ElfManifestImportTable)
+
+    def as_bytes(self):
+        return super().as_bytes() + self.import_table.as_bytes()
+
+
 def assemble_manifest_data(
     app_manifest: FlipperApplication,
     hardware_target: int,
     sdk_version,
+    app_elf: Optional[str] = None,
 ):
     image_data = b""
     if app_manifest.fap_icon:
@@ -67,16 +140,28 @@ def assemble_manifest_data(
         app_manifest.fap_version[1] & 0xFFFF
     )
 
-    data = ElfManifestBaseHeader(
-        manifest_version=1,
-        api_version=sdk_version,
-        hardware_target_id=hardware_target,
-    ).as_bytes()
-    data += ElfManifestV1(
+    manifest_args = dict(
         stack_size=app_manifest.stack_size,
         app_version=app_version_as_int,
         name=app_manifest.name,
         icon=image_data,
+    )
+    # Import table is built from the linked app, before .fapmeta is embedded
+    if app_elf:
+        manifest = ElfManifestV2(
+            **manifest_args,
+            import_table=ElfManifestImportTable(
+                ElfRelocatableFile.from_file(app_elf).imports()
+            ),
+        )
+    else:
+        manifest = ElfManifestV1(**manifest_args)
+
+    data = ElfManifestBaseHeader(
+        manifest_version=2 if app_elf else 1,
+        api_version=sdk_version,
+        hardware_target_id=hardware_target,
     ).as_bytes()
+    data += manifest.as_bytes()
 
     return data
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+
+import logging
+import os
+import random
+import time
+import zlib
+
+from flipper.app import App
+from flipper.utils.fff import FlipperFormatFile
+
+
+class LegacyFlipperFormatFile:
+    """Reader part of line list based FlipperFormatFile, as a baseline"""
+
+    def __init__(self):
+        self.lines = []
+        self.cursor = 0
+        self.logger = logging.getLogger("FlipperFormatFile")
+
+    def nextLine(self):
+        line = None
+        while self.cursor < len(self.lines):
+            temp_line = self.lines[self.cursor].strip()
+            self.cursor += 1
+            if len(temp_line) > 0 and not temp_line.startswith("#"):
+                line = temp_line
+                break
+        if line is None:
+            raise EOFError()
+        return line
+
+    def readKeyValue(self):
+        line = self.nextLine()
+        data = line.split(":", 1)
+        if len(data) != 2:
+            raise Exception("Unexpected line: not `key:value`")
+        return data[0].strip(), data[1].strip()
+
+    def readKey(self, key: str):
+        k, v = self.readKeyValue()
+        if k != key:
+            raise KeyError(f"Unexpected key {k} != {key}")
+        return v
+
+    def readKeyInt(self, key: str):
+        value = self.readKey(key)
+        return int(value) if value else None
+
+    def readKeyIntArray(self, key: str):
+        value = self.readKey(key)
+        return [int(i) for i in value.split(" ")] if value else None
+
+    def readKeyFloat(self, key: str):
+        value = self.readKey(key)
+        return float(value) if value else None
+
+    def getHeader(self):
+        _, filetype = self.readKeyValue()
+        _, version = self.readKeyValue()
+        return filetype, int(version)
+
+    def load(self, filename: str, index: bool = False):
+        with open(filename, "r") as file:
+            self.lines = file.readlines()
+
+
+class Main(App):
+    FILE_TYPE = "IR library file"
+    FILE_VERSION = 1
+
+    def init(self):
+        self.parser.add_argument(
+            "-c",
+            "--corpus",
+            help="Corpus file, generated if missing",
+            default="fff_corpus.ir",
+        )
+        self.parser.add_argument(
+            "-s", "--size", help="Corpus size in MB", type=int, default=100
+        )
+        self.parser.add_argument(
+            "-r", "--repeat", help="Runs per implementation", type=int, default=3
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def _generate(self):
+        # IR library shaped records: parsed signals and long raw timing arrays
+        rng = random.Random(0)
+        size, record = 0, 0
+        with open(self.args.corpus, "w", newline="\n") as output:
+            while size < self.args.size << 20:
+                file = FlipperFormatFile()
+                if record == 0:
+                    file.setHeader(self.FILE_TYPE, self.FILE_VERSION)
+                file.writeComment("")
+                file.writeKey("name", f"Button_{record}")
+                file.writeKey("type", "raw")
+                file.writeKey("frequency", 38000)
+                file.writeKey("duty_cycle", 0.33)
+                file.writeKey(
+                    "data",
+                    [rng.randrange(100, 10000) for _ in range(rng.randrange(16, 512))],
+                )
+                text = "\n".join(file.lines) + "\n"
+                output.write(text)
+                size += len(text)
+                record += 1
+        self.logger.info(
+            f"Generated {self.args.corpus}: {record} records, {size} bytes"
+        )
+
+    @staticmethod
+    def _parse(file, typecode=None):
+        file.getHeader()
+        records, checksum = 0, 0
+        read_array = (
+            (lambda key: file.readKeyIntArray(key, typecode))
+            if typecode
+            else file.readKeyIntArray
+        )
+        while True:
+            try:
+                checksum = zlib.crc32(file.readKey("name").encode(), checksum)
+                file.readKey("type")
+                checksum += file.readKeyInt("frequency")
+                file.readKeyFloat("duty_cycle")
+                checksum += sum(read_array("data"))
+                records += 1
+            except EOFError:
+                return records, checksum & 0xFFFFFFFF
+
+    def bench(self):
+        if not os.path.exists(self.args.corpus):
+            self._generate()
+
+        variants = (
+            ("legacy line list", LegacyFlipperFormatFile, {}, None),
+            ("streaming", FlipperFormatFile, {}, None),
+            ("streaming, array('l')", FlipperFormatFile, {}, "l"),
+            ("indexed load", FlipperFormatFile, {"index": True}, None),
+        )
+        reference = None
+        for name, implementation, load_args, typecode in variants:
+            timings = []
+            for _ in range(self.args.repeat):
+                started = time.perf_counter()
+                file = implementation()
+                file.load(self.args.corpus, **load_args)
+                result = self._parse(file, typecode)
+                timings.append(time.perf_counter() - started)
+                del file
+            if reference is None:
+                reference = result
+            elif result != reference:
+                self.logger.error(f"{name}: result mismatch {result} != {reference}")
+                return 1
+            print(
+                f"{name:<24} best {min(timings):7.3f}s  "
+                f"avg {sum(timings) / len(timings):7.3f}s  records {result[0]}"
+            )
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
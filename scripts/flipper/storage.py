@@ -87,6 +87,14 @@ class BufferedRead:
             data = self.stream.read(i)
             self.buffer.extend(data)
 
+    def read(self, size: int) -> bytes:
+        """Read up to size raw bytes, starting with already buffered ones"""
+        data = self.buffer[:size]
+        self.buffer = self.buffer[size:]
+        if len(data) < size:
+            data.extend(self.stream.read(size - len(data)))
+        return bytes(data)
+
 
 class FlipperStorage:
     CLI_PROMPT = ">: "
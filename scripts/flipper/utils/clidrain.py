@@ -0,0 +1,22 @@
+from flipper.storage import FlipperStorage
+
+
+class CliDrainError(Exception):
+    pass
+
+
+def cli_drain(cli: FlipperStorage, command: str) -> bytes:
+    """Run CLI command replying with 'Size: N' line followed by N raw bytes"""
+    cli.send_and_wait_eol(f"{command}\r")
+    answer = cli.read.until(cli.CLI_EOL)
+    if not answer.startswith(b"Size: "):
+        cli.read.until(cli.CLI_PROMPT)
+        raise CliDrainError(f"Unexpected answer to '{command}': {answer}")
+
+    size = int(answer.split(b": ")[1])
+    # Payload may have arrived in the same USB packet as the size line
+    data = cli.read.read(size)
+    cli.read.until(cli.CLI_PROMPT)
+    if len(data) != size:
+        raise CliDrainError(f"Short read: {len(data)} of {size}")
+    return data
@@ -0,0 +1,465 @@
+import re
+import struct
+import subprocess
+from dataclasses import dataclass, field
+from typing import Iterator, Optional
+
+
+class DumpReadError(Exception):
+    pass
+
+
+@dataclass
+class DwarfMember:
+    name: Optional[str]
+    type: int
+    offset: int
+    bit_size: Optional[int] = None
+    bit_offset: int = 0
+
+
+@dataclass
+class DwarfType:
+    tag: str
+    name: Optional[str] = None
+    size: Optional[int] = None
+    target: Optional[int] = None
+    signed: bool = False
+    declaration: bool = False
+    members: list[DwarfMember] = field(default_factory=list)
+    dims: list[int] = field(default_factory=list)
+
+
+class DwarfInfo:
+    """Type layouts and global variables from one readelf --debug-dump run.
+
+    Only file-level DIEs are kept: types, their members and variables with
+    static storage. Function bodies are skipped, which keeps parsing of full
+    firmware ELF reasonably fast.
+    """
+
+    TYPE_TAGS = {
+        "DW_TAG_base_type",
+        "DW_TAG_pointer_type",
+        "DW_TAG_structure_type",
+        "DW_TAG_union_type",
+        "DW_TAG_class_type",
+        "DW_TAG_array_type",
+        "DW_TAG_enumeration_type",
+        "DW_TAG_typedef",
+        "DW_TAG_const_type",
+        "DW_TAG_volatile_type",
+        "DW_TAG_atomic_type",
+        "DW_TAG_restrict_type",
+        "DW_TAG_subroutine_type",
+    }
+    AGGREGATE_TAGS = {
+        "DW_TAG_structure_type",
+        "DW_TAG_union_type",
+        "DW_TAG_class_type",
+    }
+    QUALIFIER_TAGS = {
+        "DW_TAG_typedef",
+        "DW_TAG_const_type",
+        "DW_TAG_volatile_type",
+        "DW_TAG_atomic_type",
+        "DW_TAG_restrict_type",
+    }
+    SKIPPED_SCOPES = {
+        "DW_TAG_subprogram",
+        "DW_TAG_lexical_block",
+        "DW_TAG_inlined_subroutine",
+    }
+    # Members of nested types are at depth 2, deeper DIEs are function locals
+    DWARF_DEPTH = 3
+
+    DIE_RE = re.compile(r"^\s*<(\d+)><([0-9a-f]+)>: Abbrev Number: \d+(?: \((\w+)\))?")
+    ATTR_RE = re.compile(r"^\s*<[0-9a-f]+>\s+(DW_AT_\w+)\s*: ?(.*)$")
+    # Newer binutils prefix values with form name: "(strp) (offset: 0x2c3): name"
+    FORM_RE = re.compile(r"^\(\w+\) ")
+    STRING_FORM_RE = re.compile(r"^\([^)]*offset: [^)]*\): ")
+    REF_RE = re.compile(r"<0x([0-9a-f]+)>")
+    ADDR_RE = re.compile(r"DW_OP_addr: ([0-9a-f]+)")
+    PLUS_UCONST_RE = re.compile(r"DW_OP_plus_uconst: (\d+)")
+    SYMBOL_RE = re.compile(
+        r"^\s*\d+:\s+([0-9a-f]+)\s+(\d+|0x[0-9a-f]+)\s+(\w+)\s+\w+\s+\w+\s+\S+\s+(\S+)$"
+    )
+
+    def __init__(self, elf_path: str, readelf: str = "arm-none-eabi-readelf"):
+        self.elf_path = elf_path
+        self.types: dict[int, DwarfType] = {}
+        self.variables: dict[str, tuple[int, int]] = {}
+        self.symbols: dict[str, tuple[int, int]] = {}
+        self._named: dict[str, int] = {}
+        # Struct, union and class definitions by tag, typedefs never go here:
+        # `typedef struct X X` would resolve declaration of X to itself
+        self._tags: dict[str, int] = {}
+        self._declarations: dict[int, tuple[str, int]] = {}
+        self.pointer_size = 4
+
+        self._parse_info(
+            self._run(
+                readelf,
+                "--debug-dump=info",
+                f"--dwarf-depth={self.DWARF_DEPTH}",
+                "--wide",
+            )
+        )
+        self._parse_symbols(self._run(readelf, "--syms", "--wide"))
+
+    def _run(self, readelf: str, *args: str) -> Iterator[str]:
+        with subprocess.Popen(
+            [readelf, *args, self.elf_path],
+            stdout=subprocess.PIPE,
+            text=True,
+            errors="replace",
+        ) as process:
+            yield from process.stdout
+        if process.returncode:
+            raise subprocess.CalledProcessError(process.returncode, readelf)
+
+    @classmethod
+    def _int(cls, value: str) -> Optional[int]:
+        token = value.split(None, 1)[0] if value else ""
+        try:
+            return int(token, 0)
+        except ValueError:
+            return None
+
+    def _parse_info(self, lines: Iterator[str]) -> None:
+        # DIE stack by depth: (tag, DwarfType or None)
+        scope: list[tuple[Optional[str], object]] = []
+        current = None
+        attrs: dict[str, str] = {}
+
+        def flush():
+            if current is not None:
+                self._finish_die(scope, *current, attrs)
+
+        for line in lines:
+            if match := self.DIE_RE.match(line):
+                flush()
+                depth, offset, tag = int(match[1]), int(match[2], 16), match[3]
+                del scope[depth:]
+                parent_tag = scope[-1][0] if scope else None
+                # Children of skipped DIEs and of function scopes are dropped
+                skipped = depth > 0 and (
+                    parent_tag is None or parent_tag in self.SKIPPED_SCOPES
+                )
+                scope.extend([(None, None)] * (depth - len(scope)))
+                scope.append((None, None) if skipped else (tag, None))
+                current = None if skipped or not tag else (depth, offset, tag)
+                attrs = {}
+            elif current is not None and (match := self.ATTR_RE.match(line)):
+                attrs[match[1]] = self.FORM_RE.sub("", match[2].strip())
+        flush()
+
+    def _finish_die(self, scope, depth: int, offset: int, tag: str, attrs) -> None:
+        name = attrs.get("DW_AT_name")
+        if name is not None:
+            name = self.STRING_FORM_RE.sub("", name)
+        target = (
+            int(ref[1], 16)
+            if (ref := self.REF_RE.search(attrs.get("DW_AT_type", "")))
+            else None
+        )
+        parent_tag, parent = scope[depth - 1] if depth else (None, None)
+
+        if tag in self.TYPE_TAGS:
+            die = DwarfType(
+                tag,
+                name,
+                self._int(attrs.get("DW_AT_byte_size", "")),
+                target,
+                signed="signed" in attrs.get("DW_AT_encoding", "")
+                and "unsigned" not in attrs.get("DW_AT_encoding", ""),
+                declaration="DW_AT_declaration" in attrs,
+            )
+            self.types[offset] = die
+            scope[depth] = (tag, die)
+            if tag == "DW_TAG_pointer_type" and die.size:
+                self.pointer_size = die.size
+            if name and not die.declaration and tag != "DW_TAG_base_type":
+                self._named.setdefault(name, offset)
+                if tag in self.AGGREGATE_TAGS:
+                    self._tags.setdefault(name, offset)
+        elif tag == "DW_TAG_member" and isinstance(parent, DwarfType):
+            location = attrs.get("DW_AT_data_member_location", "0")
+            if uconst := self.PLUS_UCONST_RE.search(location):
+                member_offset = int(uconst[1])
+            else:
+                member_offset = self._int(location) or 0
+            bit_offset = self._int(attrs.get("DW_AT_data_bit_offset", "")) or 0
+            parent.members.append(
+                DwarfMember(
+                    name,
+                    target,
+                    member_offset + bit_offset // 8,
+                    self._int(attrs.get("DW_AT_bit_size", "")),
+                    bit_offset % 8,
+                )
+            )
+        elif tag == "DW_TAG_subrange_type" and isinstance(parent, DwarfType):
+            if (count := self._int(attrs.get("DW_AT_count", ""))) is None:
+                upper = self._int(attrs.get("DW_AT_upper_bound", ""))
+                # Flexible array members have no or all-ones upper bound
+                count = upper + 1 if upper is not None and upper < 0xFFFFFFFF else 0
+            parent.dims.append(count)
+        elif tag == "DW_TAG_variable" and depth == 1:
+            if spec := self.REF_RE.search(attrs.get("DW_AT_specification", "")):
+                # Definition of an extern declaration, name and type live there
+                name, target = self._declarations.get(int(spec[1], 16), (name, target))
+            if not name or target is None:
+                return
+            if address := self.ADDR_RE.search(attrs.get("DW_AT_location", "")):
+                self.variables.setdefault(name, (int(address[1], 16), target))
+            else:
+                self._declarations[offset] = (name, target)
+
+    def _parse_symbols(self, lines: Iterator[str]) -> None:
+        for line in lines:
+            if match := self.SYMBOL_RE.match(line):
+                address, size, sym_type, name = match.groups()
+                if sym_type in ("OBJECT", "NOTYPE"):
+                    self.symbols.setdefault(name, (int(address, 16), int(size, 0)))
+
+    def lookup_type(self, name: str) -> int:
+        if name.startswith("struct "):
+            offset = self._tags.get(name.removeprefix("struct "))
+        else:
+            offset = self._named.get(name)
+        if offset is None:
+            raise KeyError(f"Type {name} not found in {self.elf_path}")
+        return offset
+
+    def strip(self, type_ref: Optional[int]) -> Optional[int]:
+        """Skip typedefs and qualifiers, complete forward declarations"""
+        visited = set()
+        while type_ref is not None and type_ref not in visited:
+            visited.add(type_ref)
+            die = self.types[type_ref]
+            if die.tag in self.QUALIFIER_TAGS:
+                type_ref = die.target
+            elif die.declaration and die.tag in self.AGGREGATE_TAGS:
+                if die.name not in self._tags:
+                    break
+                type_ref = self._tags[die.name]
+            else:
+                break
+        return type_ref
+
+    def sizeof(self, type_ref: Optional[int]) -> int:
+        type_ref = self.strip(type_ref)
+        if type_ref is None:
+            return 1
+        die = self.types[type_ref]
+        if die.tag == "DW_TAG_array_type":
+            count = 1
+            for dim in die.dims:
+                count *= dim
+            return count * self.sizeof(die.target)
+        if die.size is None:
+            if die.tag == "DW_TAG_pointer_type":
+                return self.pointer_size
+            raise KeyError(f"Type {die.name or type_ref} has unknown size")
+        return die.size
+
+    def find_member(
+        self, type_ref: int, name: str, base: int = 0
+    ) -> Optional[DwarfMember]:
+        # Anonymous structs and unions are searched through transparently
+        for member in self.types[self.strip(type_ref)].members:
+            if member.name == name:
+                return DwarfMember(
+                    name,
+                    member.type,
+                    base + member.offset,
+                    member.bit_size,
+                    member.bit_offset,
+                )
+            if member.name is None and (
+                nested := self.find_member(member.type, name, base + member.offset)
+            ):
+                return nested
+        return None
+
+    def has_member(self, type_ref: int, name: str) -> bool:
+        return self.find_member(type_ref, name) is not None
+
+
+class MemoryImage:
+    """Raw memory dumps, each mapped at its own base address"""
+
+    def __init__(self):
+        self.regions: list[tuple[int, bytes]] = []
+
+    def add(self, base: int, data: bytes) -> None:
+        self.regions.append((base, data))
+
+    def add_file(self, base: int, path: str) -> None:
+        with open(path, "rb") as f:
+            self.add(base, f.read())
+
+    def add_elf_sections(self, path: str) -> None:
+        """Map read-only allocated sections, strings and constants live there"""
+        with open(path, "rb") as f:
+            elf = f.read()
+        if elf[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        if elf[4] == 2:
+            header_format, section_format = "<40xQ10xHH", "<4xIQQQQ"
+        else:
+            header_format, section_format = "<32xI10xHH", "<4xIIIII"
+        section_offset, section_size, section_count = struct.unpack_from(
+            header_format, elf
+        )
+        for index in range(section_count):
+            sh_type, flags, address, offset, size = struct.unpack_from(
+                section_format, elf, section_offset + index * section_size
+            )
+            # SHT_PROGBITS with SHF_ALLOC set and SHF_WRITE clear
+            if sh_type == 1 and flags & 0x3 == 0x2 and address:
+                self.add(address, elf[offset : offset + size])
+
+    def contains(self, address: int, size: int = 1) -> bool:
+        return any(
+            base <= address and address + size <= base + len(data)
+            for base, data in self.regions
+        )
+
+    def read(self, address: int, size: int) -> bytes:
+        for base, data in self.regions:
+            if base <= address and address + size <= base + len(data):
+                return data[address - base : address - base + size]
+        raise DumpReadError(f"0x{address:08x}+{size} is outside of memory dump")
+
+
+class Value:
+    """Typed view into MemoryImage, loosely mirrors gdb.Value"""
+
+    def __init__(self, info: DwarfInfo, image: MemoryImage, type_ref, address: int):
+        self.info = info
+        self.image = image
+        self.type_ref = type_ref
+        self.address = address
+
+    @property
+    def die(self) -> Optional[DwarfType]:
+        stripped = self.info.strip(self.type_ref)
+        return None if stripped is None else self.info.types[stripped]
+
+    @property
+    def size(self) -> int:
+        return self.info.sizeof(self.type_ref)
+
+    def __getitem__(self, key):
+        die = self.die
+        if isinstance(key, str):
+            if not (member := self.info.find_member(self.type_ref, key)):
+                raise KeyError(f"No member {key} in {die.name or die.tag}")
+            value = Value(
+                self.info, self.image, member.type, self.address + member.offset
+            )
+            if member.bit_size:
+                return _BitField(value, member.bit_offset, member.bit_size)
+            return value
+        if die.tag == "DW_TAG_array_type":
+            element = Value(self.info, self.image, die.target, self.address)
+            return element._at(self.address + key * element.size)
+        if die.tag == "DW_TAG_pointer_type":
+            return self.deref()._at(int(self) + key * self.info.sizeof(die.target))
+        raise TypeError(f"{die.name or die.tag} is not indexable")
+
+    def __len__(self) -> int:
+        die = self.die
+        if die.tag != "DW_TAG_array_type":
+            raise TypeError(f"{die.name or die.tag} is not an array")
+        return self.size // max(self.info.sizeof(die.target), 1)
+
+    def _at(self, address: int) -> "Value":
+        return Value(self.info, self.image, self.type_ref, address)
+
+    def has_member(self, name: str) -> bool:
+        return self.info.has_member(self.type_ref, name)
+
+    def raw(self) -> bytes:
+        return self.image.read(self.address, self.size)
+
+    def __int__(self) -> int:
+        die = self.die
+        size = self.size
+        return int.from_bytes(
+            self.image.read(self.address, size),
+            "little",
+            signed=bool(die and die.signed),
+        )
+
+    def __bool__(self) -> bool:
+        return int(self) != 0
+
+    def deref(self) -> "Value":
+        die = self.die
+        if die is None or die.tag != "DW_TAG_pointer_type":
+            raise TypeError(f"{die.name if die else 'void'} is not a pointer")
+        return Value(self.info, self.image, die.target, int(self))
+
+    def cast(self, type_ref: int) -> "Value":
+        return Value(self.info, self.image, type_ref, self.address)
+
+    def string(self, limit: int = 256) -> str:
+        die = self.die
+        if die.tag == "DW_TAG_pointer_type":
+            address = int(self)
+            data = b""
+            while len(data) < limit:
+                chunk = self.image.read(address + len(data), 1)
+                if chunk == b"\x00":
+                    break
+                data += chunk
+        else:
+            data = self.raw()[:limit].split(b"\x00", 1)[0]
+        return data.decode("utf-8", errors="replace")
+
+
+class _BitField:
+    def __init__(self, storage: Value, bit_offset: int, bit_size: int):
+        self.storage = storage
+        self.bit_offset = bit_offset
+        self.bit_size = bit_size
+
+    def __int__(self) -> int:
+        byte_count = (self.bit_offset + self.bit_size + 7) // 8
+        raw = int.from_bytes(
+            self.storage.image.read(self.storage.address, byte_count), "little"
+        )
+        return (raw >> self.bit_offset) & ((1 << self.bit_size) - 1)
+
+    def __bool__(self) -> bool:
+        return int(self) != 0
+
+
+class DebugImage:
+    """Memory dump bound to the ELF it was taken from"""
+
+    def __init__(self, info: DwarfInfo, image: MemoryImage):
+        self.info = info
+        self.image = image
+
+    def has_variable(self, name: str) -> bool:
+        return name in self.info.variables
+
+    def variable(self, name: str) -> Value:
+        if (variable := self.info.variables.get(name)) is None:
+            raise KeyError(f"Variable {name} not found in {self.info.elf_path}")
+        address, type_ref = variable
+        return Value(self.info, self.image, type_ref, address)
+
+    def value(self, type_ref: int, address: int) -> Value:
+        return Value(self.info, self.image, type_ref, address)
+
+    def symbol_address(self, name: str) -> Optional[int]:
+        if name in self.info.variables:
+            return self.info.variables[name][0]
+        if name in self.info.symbols:
+            return self.info.symbols[name][0]
+        return None
@@ -1,43 +1,73 @@
+import json
 import logging
+from array import array
+from typing import Iterator, Optional, TextIO
 
 
 class FlipperFormatFile:
+    """FlipperFormat reader and writer
+
+    Reading streams the file: lines are pulled from the open file one at a
+    time, so memory use does not depend on file size. Loading with
+    index=True additionally keeps all key-value pairs for O(1) lookups.
+    Writing collects lines and serializes them in one pass on save.
+
+    Loaded contents are not kept, so a loaded file can't be edited in place:
+    read it, then write a new instance.
+    """
+
+    # Anything but these means value is not a plain decimal integer list
+    _INT_ARRAY_CHARS = str.maketrans("", "", "0123456789- ")
+    # Typed arrays are filled from slices of about this many characters, so
+    # the temporary list stays small however long the value is
+    _INT_ARRAY_CHUNK = 4096
+
     def __init__(self):
         # Storage
         self.lines = []
         self.cursor = 0
+        # Stream of stripped lines and one line lookahead for readComment
+        self._source: Iterator[str] = iter(())
+        self._file: Optional[TextIO] = None
+        self._loaded = False
+        self._peeked: Optional[str] = None
+        self._index: Optional[dict[str, list[str]]] = None
         # Logger
         self.logger = logging.getLogger("FlipperFormatFile")
 
-    def _resetCursor(self):
-        self.cursor = 0
+    def _peekLine(self) -> Optional[str]:
+        if self._peeked is None:
+            self._peeked = next(self._source, None)
+            if self._peeked is None:
+                self.close()
+        return self._peeked
 
-    def nextLine(self):
-        line = None
-        while self.cursor < len(self.lines):
-            temp_line = self.lines[self.cursor].strip()
-            self.cursor += 1
-            if len(temp_line) > 0 and not temp_line.startswith("#"):
-                line = temp_line
-                break
-        if line is None:
+    def _takeLine(self) -> str:
+        if (line := self._peekLine()) is None:
             raise EOFError()
+        self._peeked = None
+        self.cursor += 1
         return line
 
+    def nextLine(self):
+        while True:
+            line = self._takeLine()
+            if line and not line.startswith("#"):
+                return line
+
     def readKeyValue(self):
         line = self.nextLine()
-        data = line.split(":", 1)
-        if len(data) != 2:
+        key, separator, value = line.partition(":")
+        if not separator:
             self.logger.error(f"Incorrectly formated line {self.cursor}: `{line}`")
             raise Exception("Unexpected line: not `key:value`")
-        return data[0].strip(), data[1].strip()
+        return key.strip(), value.strip()
 
     def readComment(self):
-        if self.cursor == len(self.lines):
+        if (line := self._peekLine()) is None:
             raise EOFError()
-        line = self.lines[self.cursor].strip()
         if line.startswith("#"):
-            self.cursor += 1
+            self._takeLine()
             return line[1:].strip()
         else:
             return None
@@ -52,23 +82,79 @@ class FlipperFormatFile:
         value = self.readKey(key)
         return int(value) if value else None
 
-    def readKeyIntArray(self, key: str):
+    def readKeyIntArray(self, key: str, typecode: Optional[str] = None):
+        """Read space separated integers, into array.array if typecode is set"""
         value = self.readKey(key)
-        return [int(i) for i in value.split(" ")] if value else None
+        if not value:
+            return None
+        if not typecode:
+            return self._parseIntArray(value)
+        values = array(typecode)
+        start = 0
+        while start < len(value):
+            end = value.find(" ", start + self._INT_ARRAY_CHUNK)
+            if end < 0:
+                end = len(value)
+            values.fromlist(self._parseIntArray(value[start:end]))
+            start = end + 1
+        return values
+
+    @classmethod
+    def _parseIntArray(cls, value: str) -> list[int]:
+        # JSON decoder parses integers in C, about twice as fast as int() per
+        # item. Leading zeros, '+' or double spaces make it fail, int() then
+        # decides like before.
+        if not value.translate(cls._INT_ARRAY_CHARS):
+            try:
+                return json.loads(f"[{value.replace(' ', ',')}]")
+            except ValueError:
+                pass
+        return [int(i) for i in value.split(" ")]
+
+    def readKeyHexArray(self, key: str):
+        """Read space separated hex bytes, e.g. `Key: 00 1F A0`"""
+        value = self.readKey(key)
+        return bytes.fromhex(value) if value else None
 
     def readKeyFloat(self, key: str):
         value = self.readKey(key)
         return float(value) if value else None
 
+    def hasKey(self, key: str) -> bool:
+        return key in self._requireIndex()
+
+    def lookupKey(self, key: str, occurrence: int = 0) -> str:
+        """Value of key by index, independent from reading position"""
+        if not (values := self._requireIndex().get(key)):
+            raise KeyError(f"Key {key} not found")
+        return values[occurrence]
+
+    def lookupKeyAll(self, key: str) -> list[str]:
+        return self._requireIndex().get(key, [])
+
+    def _requireIndex(self) -> dict[str, list[str]]:
+        if self._index is None:
+            raise Exception("Key index is not built: use load(filename, index=True)")
+        return self._index
+
     def writeLine(self, line: str):
-        self.lines.insert(self.cursor, line)
+        if self._loaded:
+            raise Exception(
+                "Can't write to loaded file: contents are streamed, not kept"
+            )
+        if self.cursor == len(self.lines):
+            self.lines.append(line)
+        else:
+            self.lines.insert(self.cursor, line)
         self.cursor += 1
 
     def writeKey(self, key: str, value):
         if isinstance(value, (str, int, float)):
             pass
-        elif isinstance(value, (list, set)):
+        elif isinstance(value, (list, set, array)):
             value = " ".join(map(str, value))
+        elif isinstance(value, (bytes, bytearray)):
+            value = value.hex(" ").upper()
         else:
             raise Exception("Unknown value type")
         self.writeLine(f"{key}: {value}")
@@ -107,9 +193,35 @@ class FlipperFormatFile:
         self.writeKey("Filetype", filetype)
         self.writeKey("Version", version)
 
-    def load(self, filename: str):
-        with open(filename, "r") as file:
-            self.lines = file.readlines()
+    def close(self):
+        """Close loaded file, done automatically at its end and on next load"""
+        if self._file is not None:
+            self._file.close()
+            self._file = None
+        self._source = iter(())
+
+    def load(self, filename: str, index: bool = False):
+        self.close()
+        self.lines = []
+        self.cursor = 0
+        self._peeked = None
+        self._index = None
+        self._loaded = True
+        self._file = open(filename, "r")
+        self._source = (line.strip() for line in self._file)
+        if not index:
+            return
+
+        lines = list(self._source)
+        self.close()
+        self._source = iter(lines)
+        self._index = {}
+        for line in lines:
+            if not line or line.startswith("#"):
+                continue
+            key, separator, value = line.partition(":")
+            if separator:
+                self._index.setdefault(key.strip(), []).append(value.strip())
 
     def save(self, filename: str):
         with open(filename, "w", newline="\n") as file:
@@ -0,0 +1,272 @@
+import random
+import subprocess
+import threading
+import time
+from abc import ABC, abstractmethod
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from dataclasses import asdict, dataclass, field
+from logging import getLogger
+from typing import Callable, ClassVar, Optional
+
+from fwinterface import BaseAdapter, BaseBlackmagicAdapter, OpenOCDAdapter
+
+logger = getLogger(__name__)
+
+ProgressCallback = Callable[["FlashBackend", str], None]
+
+
+class FlashError(Exception):
+    pass
+
+
+class FlashBackend(ABC):
+    """Flashes a single device. Backends for adapter classes are looked up
+    through register(), so the scheduler does not depend on real probes."""
+
+    registry: ClassVar[dict[type, type["FlashBackend"]]] = {}
+
+    def __init__(self, device_id: str):
+        self.device_id = device_id
+
+    @classmethod
+    def register(cls, adapter_class: type):
+        def decorator(backend_class):
+            cls.registry[adapter_class] = backend_class
+            return backend_class
+
+        return decorator
+
+    @classmethod
+    def for_adapter(cls, adapter: BaseAdapter) -> "FlashBackend":
+        for adapter_class in type(adapter).__mro__:
+            if backend_class := cls.registry.get(adapter_class):
+                return backend_class(adapter)
+        raise FlashError(f"No flash backend for {adapter}")
+
+    @abstractmethod
+    def flash(self, firmware: str, verify: bool, progress: ProgressCallback) -> None:
+        """Program and optionally verify firmware, raise FlashError on failure"""
+        pass
+
+
+class SubprocessFlashBackend(FlashBackend):
+    def __init__(self, adapter: BaseAdapter):
+        super().__init__(str(adapter.serial or adapter.interface.name))
+        self.adapter = adapter
+
+    @abstractmethod
+    def get_cmdline(self, firmware: str, verify: bool) -> list[str]:
+        pass
+
+    def flash(self, firmware: str, verify: bool, progress: ProgressCallback) -> None:
+        cmdline = self.get_cmdline(firmware, verify)
+        logger.debug(f"[{self.device_id}] Running: {cmdline}")
+        # Both tools report progress on stderr, merge it for streaming
+        with subprocess.Popen(
+            cmdline,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            text=True,
+        ) as process:
+            tail = []
+            for line in process.stdout:
+                if line := line.strip():
+                    progress(self, line)
+                    tail = (tail + [line])[-5:]
+            if process.wait() != 0:
+                raise FlashError(f"exit code {process.returncode}: {' | '.join(tail)}")
+
+
+@FlashBackend.register(OpenOCDAdapter)
+class OpenOCDFlashBackend(SubprocessFlashBackend):
+    def get_cmdline(self, firmware: str, verify: bool) -> list[str]:
+        program_cmd = " ".join(
+            filter(
+                None,
+                (
+                    "program",
+                    f'"{firmware}"',
+                    "verify" if verify else "",
+                    "reset",
+                    "exit",
+                ),
+            )
+        )
+        # Each concurrent job would otherwise bind default gdb/tcl/telnet ports
+        return [
+            *self.adapter.to_args(),
+            *self.adapter.interface.no_server_args(),
+            "-c",
+            program_cmd,
+        ]
+
+
+@FlashBackend.register(BaseBlackmagicAdapter)
+class BlackmagicFlashBackend(SubprocessFlashBackend):
+    GDB_BIN = "arm-none-eabi-gdb-py3"
+
+    def get_cmdline(self, firmware: str, verify: bool) -> list[str]:
+        cmdline = [
+            self.GDB_BIN,
+            "-batch",
+            firmware,
+            *self.adapter.to_connection_args(),
+            "-ex",
+            "load",
+        ]
+        if verify:
+            cmdline.extend(("-ex", "compare-sections"))
+        return cmdline
+
+
+class FakeFlashBackend(FlashBackend):
+    """Simulated device for checking BatchFlasher without probes
+
+    Each attempt takes `delay` seconds, scaled by a random factor within
+    `jitter`, and fails with probability `failure_rate`. Peak number of
+    concurrently flashing fakes is kept in `max_active`.
+    """
+
+    PROGRESS_STEPS = 4
+
+    _lock = threading.Lock()
+    active = 0
+    max_active = 0
+
+    def __init__(
+        self,
+        device_id: str,
+        delay: float = 1.0,
+        jitter: float = 0.5,
+        failure_rate: float = 0.0,
+        seed: Optional[int] = None,
+    ):
+        super().__init__(device_id)
+        self.delay = delay
+        self.jitter = jitter
+        self.failure_rate = failure_rate
+        self.random = random.Random(seed)
+        self.attempts = 0
+
+    @classmethod
+    def reset_stats(cls):
+        with cls._lock:
+            cls.active = cls.max_active = 0
+
+    def flash(self, firmware: str, verify: bool, progress: ProgressCallback) -> None:
+        cls = type(self)
+        with cls._lock:
+            cls.active += 1
+            cls.max_active = max(cls.max_active, cls.active)
+        try:
+            self.attempts += 1
+            duration = self.delay * self.random.uniform(
+                1 - self.jitter, 1 + self.jitter
+            )
+            fail_at = None
+            if self.random.random() < self.failure_rate:
+                fail_at = self.random.randrange(self.PROGRESS_STEPS)
+            for step in range(self.PROGRESS_STEPS):
+                time.sleep(duration / self.PROGRESS_STEPS)
+                if step == fail_at:
+                    raise FlashError(f"simulated failure at step {step}")
+                progress(
+                    self,
+                    f"** Programming {firmware}: {(step + 1) * 100 // self.PROGRESS_STEPS}% **",
+                )
+            if verify:
+                progress(self, "** Verified OK **")
+        finally:
+            with cls._lock:
+                cls.active -= 1
+
+
+@dataclass
+class FlashResult:
+    device: str
+    success: bool
+    started: float
+    duration: float
+    attempts: int
+    error: Optional[str] = None
+    log: list[str] = field(default_factory=list)
+
+
+class BatchFlasher:
+    """Flashes several devices concurrently with bounded parallelism"""
+
+    LOG_LINES_KEPT = 20
+
+    def __init__(
+        self,
+        backends: list[FlashBackend],
+        jobs: int = 4,
+        retries: int = 0,
+        on_progress: Optional[ProgressCallback] = None,
+    ):
+        self.backends = backends
+        self.jobs = max(jobs, 1)
+        self.retries = retries
+        self.on_progress = on_progress
+        self._lock = threading.Lock()
+
+    def _flash_one(self, backend: FlashBackend, firmware: str, verify: bool):
+        log = []
+
+        def progress(backend: FlashBackend, line: str):
+            log.append(line)
+            del log[: -self.LOG_LINES_KEPT]
+            if self.on_progress:
+                with self._lock:
+                    self.on_progress(backend, line)
+
+        started = time.time()
+        error = None
+        for attempt in range(1, self.retries + 2):
+            try:
+                backend.flash(firmware, verify, progress)
+                error = None
+                break
+            except Exception as e:
+                error = str(e) or type(e).__name__
+                progress(backend, f"attempt {attempt} failed: {error}")
+
+        return FlashResult(
+            device=backend.device_id,
+            success=error is None,
+            started=started,
+            duration=time.time() - started,
+            attempts=attempt,
+            error=error,
+            log=log,
+        )
+
+    def run(
+        self,
+        firmware: str,
+        verify: bool = True,
+        on_result: Optional[Callable[[FlashResult], None]] = None,
+    ) -> list[FlashResult]:
+        results = []
+        with ThreadPoolExecutor(max_workers=self.jobs) as pool:
+            futures = [
+                pool.submit(self._flash_one, backend, firmware, verify)
+                for backend in self.backends
+            ]
+            for future in as_completed(futures):
+                result = future.result()
+                results.append(result)
+                if on_result:
+                    on_result(result)
+        results.sort(key=lambda result: result.device)
+        return results
+
+    @staticmethod
+    def make_report(firmware: str, results: list[FlashResult]) -> dict:
+        return {
+            "firmware": firmware,
+            "total": len(results),
+            "passed": sum(result.success for result in results),
+            "failed": sum(not result.success for result in results),
+            "results": [asdict(result) for result in results],
+        }
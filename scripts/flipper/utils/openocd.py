@@ -8,6 +8,12 @@ class OpenOCD:
 
     COMMAND_TOKEN = "\x1a"
 
+    # Max commands in flight for pipelined TCL requests
+    PIPELINE_DEPTH = 32
+
+    # Max words per single read_memory/write_memory command
+    BLOCK_WORDS_MAX = 256
+
     def __init__(self, config: dict = {}) -> None:
         assert isinstance(config, dict)
 
@@ -73,8 +79,14 @@ class OpenOCD:
 
         self._wait_for_openocd_tcl()
 
+        self.connect()
+
+    def connect(self, host: str = "127.0.0.1"):
+        """Connect to TCL RPC port of running OpenOCD"""
+        self._rx_buffer = bytearray()
         self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-        self.socket.connect(("127.0.0.1", self.tcl_port))
+        self.socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.socket.connect((host, self.tcl_port))
 
     def _wait_for_openocd_tcl(self):
         """Wait for OpenOCD to start"""
@@ -105,21 +117,43 @@ class OpenOCD:
 
     def send_tcl(self, cmd) -> str:
         """Send a command string to TCL RPC. Return the result that was read."""
-
+        return self.send_tcl_pipelined([cmd])[0]
+
+    def send_tcl_pipelined(self, cmds: list[str]) -> list[str]:
+        """Send several commands without waiting for each reply.
+
+        OpenOCD executes commands in order and terminates each reply with the
+        token, so replies are matched to commands by position. At most
+        PIPELINE_DEPTH commands are in flight to keep socket buffers bounded.
+        """
+        results = []
+        in_flight = 0
+        for cmd in cmds:
+            if in_flight == self.PIPELINE_DEPTH:
+                results.append(self._recv_checked())
+                in_flight -= 1
+            self._send_checked(cmd)
+            in_flight += 1
+        while in_flight:
+            results.append(self._recv_checked())
+            in_flight -= 1
+        return results
+
+    def _send_checked(self, cmd: str) -> None:
         try:
             data = (cmd + OpenOCD.COMMAND_TOKEN).encode("utf-8")
             self.logger.debug(f"<- {data}")
 
-            self.socket.send(data)
+            self.socket.sendall(data)
         except Exception as e:
             self.logger.error("Failed to send command to OpenOCD")
             self.logger.exception(e)
             self.postmortem()
             raise
 
+    def _recv_checked(self) -> str:
         try:
-            data = self._recv()
-            return data
+            return self._recv()
         except Exception as e:
             self.logger.error("Failed to receive response from OpenOCD")
             self.logger.exception(e)
@@ -129,19 +163,20 @@ class OpenOCD:
     def _recv(self):
         """Read from the stream until the token (\x1a) was received."""
         # TODO FL-3538: timeout
-        data = bytes()
-        while True:
+        token = OpenOCD.COMMAND_TOKEN.encode("utf-8")
+        while (end := self._rx_buffer.find(token)) < 0:
             chunk = self.socket.recv(4096)
-            data += chunk
-            if bytes(OpenOCD.COMMAND_TOKEN, encoding="utf-8") in chunk:
-                break
+            if not chunk:
+                raise ConnectionError("OpenOCD closed TCL connection")
+            self._rx_buffer += chunk
 
-        self.logger.debug(f"-> {data}")
+        # Keep whatever follows the token, it belongs to the next reply
+        data = bytes(self._rx_buffer[:end])
+        del self._rx_buffer[: end + 1]
 
-        data = data.decode("utf-8").strip()
-        data = data[:-1]  # strip trailing \x1a
+        self.logger.debug(f"-> {data}")
 
-        return data
+        return data.decode("utf-8").strip()
 
     def postmortem(self) -> None:
         """Postmortem analysis of the OpenOCD process"""
@@ -171,3 +206,41 @@ class OpenOCD:
     def write_32(self, addr: int, value: int) -> None:
         """Write 32-bit value to memory"""
         self.send_tcl(f"mww {addr} {value}")
+
+    def read_block_32(self, addr: int, count: int) -> list[int]:
+        """Read count consecutive 32-bit values from memory"""
+        cmds = [
+            f"read_memory 0x{addr + offset * 4:08x} 32 {min(count - offset, self.BLOCK_WORDS_MAX)}"
+            for offset in range(0, count, self.BLOCK_WORDS_MAX)
+        ]
+        values = []
+        for reply in self.send_tcl_pipelined(cmds):
+            values.extend(int(word, 16) for word in reply.split())
+        if len(values) != count:
+            raise Exception(
+                f"Block read at 0x{addr:08x}: got {len(values)} of {count} words"
+            )
+        return values
+
+    def read_block(self, addr: int, size: int) -> bytes:
+        """Read size bytes from memory, size must be multiple of 4"""
+        if size % 4:
+            raise ValueError("Block size must be multiple of 4")
+        return b"".join(
+            value.to_bytes(4, "little") for value in self.read_block_32(addr, size // 4)
+        )
+
+    def write_block_32(self, addr: int, values: list[int]) -> None:
+        """Write consecutive 32-bit values to memory"""
+        cmds = []
+        for offset in range(0, len(values), self.BLOCK_WORDS_MAX):
+            chunk = values[offset : offset + self.BLOCK_WORDS_MAX]
+            words = " ".join(f"0x{value:08x}" for value in chunk)
+            cmds.append(f"write_memory 0x{addr + offset * 4:08x} 32 {{{words}}}")
+        self.send_tcl_pipelined(cmds)
+
+    def write_32_many(self, writes: list[tuple[int, int]]) -> None:
+        """Write 32-bit values to scattered addresses, preserving order"""
+        self.send_tcl_pipelined(
+            [f"mww 0x{addr:08x} 0x{value:08x}" for addr, value in writes]
+        )
@@ -0,0 +1,200 @@
+import queue
+import shlex
+import socket
+import socketserver
+import threading
+import time
+from dataclasses import dataclass
+from logging import getLogger
+
+from flipper.utils.openocd import OpenOCD
+
+logger = getLogger(__name__)
+
+
+@dataclass
+class MemoryRegion:
+    name: str
+    start: int
+    size: int
+
+    def contains(self, addr: int, size: int) -> bool:
+        return self.start <= addr and addr + size <= self.start + self.size
+
+
+class MemoryMap:
+    """Sparse 32-bit word storage limited to declared regions"""
+
+    # STM32WB55 regions touched by flipper.utils.stm32wb55
+    DEFAULT_REGIONS = (
+        MemoryRegion("flash", 0x08000000, 0x100000),
+        MemoryRegion("sram1", 0x20000000, 0x30000),
+        MemoryRegion("otp", 0x1FFF7000, 0x400),
+        MemoryRegion("option_bytes", 0x1FFF8000, 0x1000),
+        MemoryRegion("flash_regs", 0x58004000, 0x400),
+    )
+
+    def __init__(self, regions=DEFAULT_REGIONS, fill: int = 0xFFFFFFFF):
+        self.regions = list(regions)
+        self.fill = fill
+        self.words: dict[int, int] = {}
+
+    def _check(self, addr: int, count: int):
+        if addr % 4:
+            raise ValueError(f"unaligned address 0x{addr:08x}")
+        if not any(region.contains(addr, count * 4) for region in self.regions):
+            raise ValueError(f"0x{addr:08x}+{count * 4} is outside memory map")
+
+    def read(self, addr: int, count: int) -> list[int]:
+        self._check(addr, count)
+        return [self.words.get(addr + i * 4, self.fill) for i in range(count)]
+
+    def write(self, addr: int, values: list[int]):
+        self._check(addr, len(values))
+        for i, value in enumerate(values):
+            self.words[addr + i * 4] = value & 0xFFFFFFFF
+
+
+class _TclHandler(socketserver.BaseRequestHandler):
+    def setup(self):
+        self.request.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.replies = queue.Queue()
+        self.sender = threading.Thread(target=self._send_replies, daemon=True)
+        self.sender.start()
+
+    def handle(self):
+        token = OpenOCD.COMMAND_TOKEN.encode("utf-8")
+        buffer = bytearray()
+        while True:
+            while (end := buffer.find(token)) < 0:
+                chunk = self.request.recv(4096)
+                if not chunk:
+                    return
+                buffer += chunk
+            cmd = buffer[:end].decode("utf-8")
+            del buffer[: end + 1]
+
+            reply, stop = self.server.stub.execute(cmd)
+            self.replies.put((time.monotonic() + self.server.stub.latency, reply))
+            if stop:
+                return
+
+    def finish(self):
+        self.replies.put(None)
+        self.sender.join()
+
+    def _send_replies(self):
+        # Replies are delayed independently of each other: latency models
+        # the link, not the target, so pipelined commands overlap
+        while (item := self.replies.get()) is not None:
+            due, reply = item
+            if (delay := due - time.monotonic()) > 0:
+                time.sleep(delay)
+            try:
+                self.request.sendall((reply + OpenOCD.COMMAND_TOKEN).encode("utf-8"))
+            except OSError:
+                return
+
+
+class OpenOCDStub:
+    """Stand-in for OpenOCD TCL RPC server backed by MemoryMap
+
+    Implements memory commands used by flipper.utils.openocd: mdw, mww, mmw,
+    read_memory and write_memory. Other commands are accepted and return an
+    empty reply. Each reply is delayed by `latency` seconds from command
+    arrival, commands are executed in order and take `command_time` each.
+    """
+
+    def __init__(
+        self,
+        memory: MemoryMap = None,
+        latency: float = 0.002,
+        command_time: float = 0.0,
+        host: str = "127.0.0.1",
+        port: int = 0,
+    ):
+        self.memory = memory or MemoryMap()
+        self.latency = latency
+        self.command_time = command_time
+        self.commands = 0
+        self._lock = threading.Lock()
+        self.server = socketserver.ThreadingTCPServer(
+            (host, port), _TclHandler, bind_and_activate=False
+        )
+        self.server.allow_reuse_address = True
+        self.server.daemon_threads = True
+        self.server.server_bind()
+        self.server.server_activate()
+        self.server.stub = self
+        self.thread = None
+
+    @property
+    def port(self) -> int:
+        return self.server.server_address[1]
+
+    def start(self):
+        self.thread = threading.Thread(target=self.server.serve_forever, daemon=True)
+        self.thread.start()
+        logger.debug(f"OpenOCD stub listening on port {self.port}")
+
+    def serve_forever(self):
+        self.server.serve_forever()
+
+    def stop(self):
+        self.server.shutdown()
+        self.server.server_close()
+        if self.thread:
+            self.thread.join()
+
+    def __enter__(self):
+        self.start()
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.stop()
+
+    def execute(self, cmd: str) -> tuple[str, bool]:
+        """Run command, return reply and whether connection should close"""
+        with self._lock:
+            self.commands += 1
+            if self.command_time:
+                time.sleep(self.command_time)
+            try:
+                args = shlex.split(cmd.replace("{", '"').replace("}", '"'))
+            except ValueError as e:
+                return f"invalid command: {e}", False
+            if not args:
+                return "", False
+            name, args = args[0], args[1:]
+            if name in ("exit", "shutdown"):
+                return "", True
+            if not (handler := getattr(self, f"_cmd_{name}", None)):
+                return "", False
+            try:
+                return handler(*(int(arg, 0) for arg in " ".join(args).split())), False
+            except (ValueError, TypeError) as e:
+                return f"{name}: {e}", False
+
+    def _cmd_mdw(self, addr, count=1):
+        values = self.memory.read(addr, count)
+        return f"0x{addr:08x}: " + " ".join(f"{value:08x}" for value in values)
+
+    def _cmd_mww(self, addr, value):
+        self.memory.write(addr, [value])
+        return ""
+
+    def _cmd_mmw(self, addr, set_mask, clear_mask):
+        value = self.memory.read(addr, 1)[0]
+        self.memory.write(addr, [(value & ~clear_mask) | set_mask])
+        return ""
+
+    def _cmd_read_memory(self, addr, width, count):
+        if width != 32:
+            raise ValueError(f"unsupported width {width}")
+        return " ".join(f"0x{value:08x}" for value in self.memory.read(addr, count))
+
+    def _cmd_write_memory(self, addr, width, *values):
+        if width != 32:
+            raise ValueError(f"unsupported width {width}")
+        self.memory.write(addr, list(values))
+        return ""
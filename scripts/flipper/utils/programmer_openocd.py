@@ -111,11 +111,7 @@ class OpenOCDProgrammer(Programmer):
         ob_words = int(ob_length / 4)
 
         # Read Option Bytes
-        ob_read = bytes()
-        for i in range(ob_words):
-            addr = stm32.OPTION_BYTE_BASE + i * 4
-            value = self.openocd.read_32(addr)
-            ob_read += value.to_bytes(4, "little")
+        ob_read = self.openocd.read_block(stm32.OPTION_BYTE_BASE, ob_words * 4)
 
         # Compare Option Bytes with reference by mask
         ob_compare = bytes()
@@ -166,10 +162,16 @@ class OpenOCDProgrammer(Programmer):
         stm32.option_bytes_unlock()
 
         ob_need_to_apply = False
+        ob_register_writes = []
+
+        # Only the first word of each dword carries option values
+        device_values = self.openocd.read_block_32(
+            stm32.OPTION_BYTE_BASE, ob_dwords * 2
+        )[::2]
 
         for i in range(ob_dwords):
             device_addr = stm32.OPTION_BYTE_BASE + i * 8
-            device_value = self.openocd.read_32(device_addr)
+            device_value = device_values[i]
             ob_write_mask = self._unpack_u32(ob_write_mask_bytes, i * 8)
             ob_compare_mask = self._unpack_u32(ob_compare_mask_bytes, i * 8)
             ob_value_ref = self._unpack_u32(ob_reference_bytes, i * 8)
@@ -191,9 +193,10 @@ class OpenOCDProgrammer(Programmer):
                 ob_value |= ob_value_ref & ob_write_mask
 
                 self.logger.info(f"Writing {ob_value:08X} to {device_reg_addr:08X}")
-                self.openocd.write_32(device_reg_addr, ob_value)
+                ob_register_writes.append((device_reg_addr, ob_value))
 
         if ob_need_to_apply:
+            self.openocd.write_32_many(ob_register_writes)
             stm32.option_bytes_apply()
         else:
             self.logger.info("Option Bytes are already correct")
@@ -242,9 +245,10 @@ class OpenOCDProgrammer(Programmer):
             # Check that OTP is empty for the given address
             # Also check that data is already written
             already_written = True
+            device_data = self.openocd.read_block(address, data_size)
             for i in range(0, data_size, 4):
                 file_word = int.from_bytes(data[i : i + 4], "little")
-                device_word = self.openocd.read_32(address + i)
+                device_word = int.from_bytes(device_data[i : i + 4], "little")
                 if device_word != 0xFFFFFFFF and device_word != file_word:
                     self.logger.error(
                         f"OTP memory at {address + i:08X} is not empty: {device_word:08X}"
@@ -273,9 +277,10 @@ class OpenOCDProgrammer(Programmer):
             # Validate OTP memory
             validation_result = True
 
+            device_data = self.openocd.read_block(address, data_size)
             for i in range(0, data_size, 4):
                 file_word = int.from_bytes(data[i : i + 4], "little")
-                device_word = self.openocd.read_32(address + i)
+                device_word = int.from_bytes(device_data[i : i + 4], "little")
                 if file_word != device_word:
                     self.logger.error(
                         f"Validation failed: {file_word:08X} != {device_word:08X} at {address + i:08X}"
@@ -294,9 +294,7 @@ class STM32WB55:
             self.logger.error("Address must be aligned to 8 bytes")
             raise Exception("Address must be aligned to 8 bytes")
 
-        if word_1 == self.openocd.read_32(address) and word_2 == self.openocd.read_32(
-            address + 4
-        ):
+        if [word_1, word_2] == self.openocd.read_block_32(address, 2):
             self.logger.debug("Data is already programmed")
             return
 
@@ -330,10 +328,7 @@ class STM32WB55:
         self.FLASH_CR.store()
 
         # Perform the data write operation at the desired memory address, only double word (64 bits) can be programmed.
-        # Write the first word
-        self.openocd.send_tcl(f"mww 0x{address:08x} 0x{word_1:08x}")
-        # Write the second word
-        self.openocd.send_tcl(f"mww 0x{(address + 4):08x} 0x{word_2:08x}")
+        self.openocd.write_32_many([(address, word_1), (address + 4, word_2)])
 
         # Wait for the BSY bit to be cleared
         self.flash_wait_for_operation()
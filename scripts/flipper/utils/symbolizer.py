@@ -0,0 +1,58 @@
+import subprocess
+from dataclasses import dataclass
+from typing import Iterable
+
+
+@dataclass(frozen=True)
+class Symbol:
+    address: int
+    function: str
+    location: str
+
+    def __str__(self):
+        return self.function if self.function != "??" else f"0x{self.address:08x}"
+
+
+class Symbolizer:
+    """Resolves code addresses against an ELF with a single addr2line run per batch"""
+
+    def __init__(
+        self, elf_path: str | None, addr2line: str = "arm-none-eabi-addr2line"
+    ):
+        self.elf_path = elf_path
+        self.addr2line = addr2line
+        self._cache: dict[int, Symbol] = {}
+
+    @staticmethod
+    def return_address_to_call_site(address: int) -> int:
+        # Strip Thumb bit and step back into the call instruction
+        return max((address & ~1) - 1, 0)
+
+    def resolve_many(self, addresses: Iterable[int]) -> None:
+        pending = sorted(set(addresses) - self._cache.keys())
+        if not pending:
+            return
+        if not self.elf_path:
+            for address in pending:
+                self._cache[address] = Symbol(address, "??", "??:0")
+            return
+
+        output = subprocess.check_output(
+            [
+                self.addr2line,
+                "-f",
+                "-C",
+                "-e",
+                self.elf_path,
+                *(f"0x{address:x}" for address in pending),
+            ],
+            shell=False,
+        )
+        lines = output.decode("utf-8", errors="replace").splitlines()
+        for idx, address in enumerate(pending):
+            function, location = lines[2 * idx : 2 * idx + 2]
+            self._cache[address] = Symbol(address, function, location)
+
+    def resolve(self, address: int) -> Symbol:
+        self.resolve_many((address,))
+        return self._cache[address]
@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import os
+import posixpath
+import statistics
+import subprocess
+import time
+from collections import defaultdict
+from datetime import datetime, timezone
+from statistics import NormalDist
+
+from flipper.app import App
+
+
+class BenchParseError(Exception):
+    pass
+
+
+def parse_bench_output(prefix: str, text: str) -> dict[str, list[float]]:
+    """Result lines of furi_hal_bench_run() -> case: [ns per iteration]"""
+    samples = defaultdict(list)
+    done = None
+    for line in text.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[0] == "bench":
+            _, name, iterations, elapsed_ns = fields
+            samples[f"{prefix}/{name}"].append(int(elapsed_ns) / int(iterations))
+        elif len(fields) == 2 and fields[0] == "bench-done":
+            done = int(fields[1])
+    if done is None:
+        raise BenchParseError(f"{prefix}: no bench-done line, run was interrupted")
+    if done != len(samples):
+        raise BenchParseError(f"{prefix}: {done} cases run, {len(samples)} reported")
+    return dict(samples)
+
+
+def mann_whitney_greater(current: list[float], baseline: list[float]) -> float:
+    """One-sided p-value of current being slower than baseline
+
+    Mann-Whitney U with tie-corrected normal approximation: no assumptions
+    on distribution shape, which timing samples with outliers do not meet.
+    """
+    n1, n2 = len(current), len(baseline)
+    ranked = sorted([(v, 0) for v in current] + [(v, 1) for v in baseline])
+    rank_sum, tie_term, i = 0.0, 0, 0
+    while i < len(ranked):
+        j = i
+        while j < len(ranked) and ranked[j][0] == ranked[i][0]:
+            j += 1
+        rank = (i + j + 1) / 2
+        rank_sum += rank * sum(1 for _, group in ranked[i:j] if group == 0)
+        tie_term += (j - i) ** 3 - (j - i)
+        i = j
+
+    u = rank_sum - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (u - n1 * n2 / 2 - 0.5) / variance**0.5
+    return 1 - NormalDist().cdf(z)
+
+
+class BenchDatabase:
+    """JSON results store: revision -> target -> run"""
+
+    VERSION = 1
+
+    def __init__(self, path: str):
+        self.path = path
+        self.revisions = {}
+        if os.path.exists(path):
+            with open(path, "r") as f:
+                data = json.load(f)
+            if data.get("version") != self.VERSION:
+                raise Exception(f"{path}: unsupported version {data.get('version')}")
+            self.revisions = data["revisions"]
+
+    def get(self, revision: str, target: str) -> dict | None:
+        return self.revisions.get(revision, {}).get(target)
+
+    def put(self, revision: str, target: str, run: dict):
+        self.revisions.setdefault(revision, {})[target] = run
+
+    def save(self):
+        os.makedirs(os.path.dirname(os.path.abspath(self.path)), exist_ok=True)
+        with open(self.path, "w") as f:
+            json.dump(
+                {"version": self.VERSION, "revisions": self.revisions}, f, indent=1
+            )
+
+
+class Main(App):
+    DEVICE_APP_DIR = "/ext/apps/.bench"
+    DEVICE_OUTPUT_PATH = "/ext/.bench.txt"
+    DEVICE_POLL_INTERVAL = 1
+
+    def init(self):
+        self.parser.add_argument(
+            "--db", help="Results database", default="build/bench/results.json"
+        )
+        self.parser.add_argument("-t", "--target", help="Hardware target", default="7")
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_run = self.subparsers.add_parser(
+            "run", help="Run benchmarks and store results for current revision"
+        )
+        self.run_subparsers = self.parser_run.add_subparsers(help="runner")
+        # Shared by runners, so options can follow runner arguments
+        run_options = argparse.ArgumentParser(add_help=False)
+        run_options.add_argument(
+            "--append",
+            action="store_true",
+            help="Add samples to stored results instead of replacing them",
+        )
+        run_options.add_argument(
+            "--no-store", action="store_true", help="Only print results"
+        )
+        run_options.add_argument(
+            "--timeout", help="Timeout per benchmark, s", type=int, default=300
+        )
+
+        self.parser_host = self.run_subparsers.add_parser(
+            "host", help="Run host benchmark programs", parents=[run_options]
+        )
+        self.parser_host.add_argument("programs", nargs="*", help="Programs")
+        self.parser_host.set_defaults(func=self.run_host)
+
+        self.parser_device = self.run_subparsers.add_parser(
+            "device", help="Run benchmark .faps on Flipper", parents=[run_options]
+        )
+        self.parser_device.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_device.add_argument(
+            "--fap-dir", help="Directory with built .faps", required=True
+        )
+        self.parser_device.add_argument("appids", nargs="*", help="Benchmark apps")
+        self.parser_device.set_defaults(func=self.run_device)
+
+        self.parser_compare = self.subparsers.add_parser(
+            "compare", help="Compare revision results against baseline"
+        )
+        self.parser_compare.add_argument(
+            "-b",
+            "--baseline",
+            help="Baseline revision, default is closest stored ancestor",
+        )
+        self.parser_compare.add_argument(
+            "-r", "--revision", help="Revision to check, default is current"
+        )
+        self.parser_compare.add_argument(
+            "--alpha", help="Significance level", type=float, default=0.01
+        )
+        self.parser_compare.add_argument(
+            "--threshold",
+            help="Minimal median change to report, percent",
+            type=float,
+            default=3.0,
+        )
+        self.parser_compare.set_defaults(func=self.compare)
+
+        self.parser_list = self.subparsers.add_parser(
+            "list", help="List stored revisions"
+        )
+        self.parser_list.set_defaults(func=self.list_runs)
+
+    @staticmethod
+    def _git(*args) -> str:
+        return subprocess.check_output(["git", *args], text=True).strip()
+
+    def _current_revision(self) -> str:
+        revision = self._git("rev-parse", "HEAD")
+        if self._git("status", "--porcelain", "--untracked-files=no"):
+            revision += "-dirty"
+        return revision
+
+    def _resolve_revision(self, db: BenchDatabase, name: str) -> str:
+        if name in db.revisions:
+            return name
+        try:
+            return self._git("rev-parse", "--verify", f"{name}^{{commit}}")
+        except subprocess.CalledProcessError:
+            raise Exception(f"Unknown revision {name}")
+
+    def _closest_stored_ancestor(self, db: BenchDatabase, revision: str) -> str | None:
+        start = revision.removesuffix("-dirty")
+        for ancestor in self._git("rev-list", "--first-parent", start).splitlines():
+            if ancestor != revision and db.get(ancestor, self.args.target):
+                return ancestor
+        return None
+
+    def _store(self, samples: dict[str, list[float]]):
+        for name, values in sorted(samples.items()):
+            print(
+                f"{name:<48} median {statistics.median(values):12.1f} ns  "
+                f"samples {len(values)}"
+            )
+        if self.args.no_store:
+            return 0
+
+        db = BenchDatabase(self.args.db)
+        revision = self._current_revision()
+        benchmarks = {}
+        if self.args.append and (stored := db.get(revision, self.args.target)):
+            benchmarks = stored["benchmarks"]
+        for name, values in samples.items():
+            benchmarks.setdefault(name, []).extend(values)
+        db.put(
+            revision,
+            self.args.target,
+            {
+                "timestamp": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+                "benchmarks": benchmarks,
+            },
+        )
+        db.save()
+        self.logger.info(f"Stored {len(samples)} benchmarks for {revision}")
+        return 0
+
+    def run_host(self):
+        samples = {}
+        for program in self.args.programs:
+            name = os.path.basename(program).removeprefix("bench_")
+            self.logger.info(f"Running {name}")
+            result = subprocess.run(
+                [os.path.abspath(program)],
+                capture_output=True,
+                text=True,
+                timeout=self.args.timeout,
+            )
+            if result.returncode != 0:
+                self.logger.error(
+                    f"{name} exited with {result.returncode}: {result.stderr.strip()}"
+                )
+                return 1
+            samples.update(parse_bench_output(name, result.stdout))
+        return self._store(samples)
+
+    def _run_device_app(self, storage, appid: str) -> str:
+        from flipper.storage import FlipperStorageException
+
+        if storage.exist_file(self.DEVICE_OUTPUT_PATH):
+            storage.remove(self.DEVICE_OUTPUT_PATH)
+        app_path = posixpath.join(self.DEVICE_APP_DIR, f"{appid}.fap")
+        storage.send_and_wait_prompt(f'loader open "{app_path}"\r')
+
+        deadline = time.monotonic() + self.args.timeout
+        while time.monotonic() < deadline:
+            time.sleep(self.DEVICE_POLL_INTERVAL)
+            try:
+                text = storage.read_file(self.DEVICE_OUTPUT_PATH).decode("utf-8")
+            except FlipperStorageException:
+                continue
+            # Result file is complete once harness wrote its last line
+            if "bench-done" in text:
+                return text
+        raise TimeoutError(f"{appid}: no results in {self.args.timeout}s")
+
+    def run_device(self):
+        # Serial dependencies are only needed for device runs
+        from flipper.storage import FlipperStorage, FlipperStorageOperations
+        from flipper.utils.cdc import resolve_port
+
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+
+        samples = {}
+        with FlipperStorage(port) as storage:
+            operations = FlipperStorageOperations(storage)
+            operations.mkpath(self.DEVICE_APP_DIR)
+            for appid in self.args.appids:
+                fap_path = os.path.join(self.args.fap_dir, f"{appid}.fap")
+                if not os.path.exists(fap_path):
+                    self.logger.error(f"{fap_path} not found, was it built?")
+                    return 1
+                operations.send_file_to_storage(
+                    posixpath.join(self.DEVICE_APP_DIR, f"{appid}.fap"), fap_path
+                )
+                self.logger.info(f"Running {appid}")
+                samples.update(
+                    parse_bench_output(appid, self._run_device_app(storage, appid))
+                )
+        return self._store(samples)
+
+    def compare(self):
+        db = BenchDatabase(self.args.db)
+        revision = (
+            self._resolve_revision(db, self.args.revision)
+            if self.args.revision
+            else self._current_revision()
+        )
+        if not (current := db.get(revision, self.args.target)):
+            self.logger.error(f"No results for {revision} on target {self.args.target}")
+            return 1
+
+        if self.args.baseline:
+            baseline_revision = self._resolve_revision(db, self.args.baseline)
+        elif not (baseline_revision := self._closest_stored_ancestor(db, revision)):
+            self.logger.error("No stored ancestor results, pass --baseline")
+            return 1
+        if not (baseline := db.get(baseline_revision, self.args.target)):
+            self.logger.error(f"No results for baseline {baseline_revision}")
+            return 1
+        self.logger.info(f"Comparing {revision} against {baseline_revision}")
+
+        print(
+            f"{'benchmark':<48} {'baseline':>12} {'current':>12} {'change':>8} "
+            f"{'p':>7}  verdict"
+        )
+        regressions = 0
+        for name in sorted(current["benchmarks"].keys() | baseline["benchmarks"]):
+            new, old = current["benchmarks"].get(name), baseline["benchmarks"].get(name)
+            if not new or not old:
+                print(f"{name:<48} {'added' if new else 'removed':>12}")
+                continue
+            old_median, new_median = statistics.median(old), statistics.median(new)
+            change = (new_median / old_median - 1) * 100 if old_median else 0.0
+            if change >= 0:
+                p_value = mann_whitney_greater(new, old)
+            else:
+                p_value = mann_whitney_greater(old, new)
+
+            verdict = ""
+            if p_value < self.args.alpha and abs(change) >= self.args.threshold:
+                if change > 0:
+                    verdict = "REGRESSION"
+                    regressions += 1
+                else:
+                    verdict = "improvement"
+            print(
+                f"{name:<48} {old_median:12.1f} {new_median:12.1f} {change:+7.1f}% "
+                f"{p_value:7.4f}  {verdict}"
+            )
+
+        if regressions:
+            self.logger.error(f"{regressions} significant regressions")
+            return 1
+        return 0
+
+    def list_runs(self):
+        db = BenchDatabase(self.args.db)
+        for revision, targets in sorted(
+            db.revisions.items(),
+            key=lambda item: max(run["timestamp"] for run in item[1].values()),
+        ):
+            for target, run in sorted(targets.items()):
+                print(
+                    f"{revision:<48} f{target:<4} {run['timestamp']}  "
+                    f"{len(run['benchmarks'])} benchmarks"
+                )
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
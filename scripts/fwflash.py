@@ -1,6 +1,8 @@
 #!/usr/bin/env python3
 
 import argparse
+import json
+import logging
 import signal
 import subprocess
 from typing import Iterable
@@ -11,7 +13,13 @@ from flipper.debug.extensions import (
     CoreConfigurationExtension,
     RemoteParametesExtension,
 )
-from fwinterface import OpenOCDAdapter, OpenOCDCommandLineParameter
+from flipper.utils.flashbatch import BatchFlasher, FakeFlashBackend, FlashBackend
+from fwinterface import (
+    INTERFACES,
+    OpenOCDAdapter,
+    OpenOCDCommandLineParameter,
+    discover_all_probes,
+)
 
 
 class FlashExtension(BaseDebugExtension):
@@ -46,6 +54,47 @@ class Main(App):
 
     def init(self):
         GdbConfigurationManager.configure_arg_parser(self.parser)
+        self.parser.add_argument(
+            "--batch",
+            action="store_true",
+            help="Flash all attached devices concurrently. "
+            "Use --serial with comma-separated list to limit adapters",
+        )
+        self.parser.add_argument(
+            "-j",
+            "--jobs",
+            type=int,
+            default=4,
+            help="Max devices flashed in parallel in batch mode",
+        )
+        self.parser.add_argument(
+            "--retries",
+            type=int,
+            default=0,
+            help="Retries per device in batch mode",
+        )
+        self.parser.add_argument(
+            "--report",
+            help="Write batch results as JSON to this file",
+        )
+        self.parser.add_argument(
+            "--fake-devices",
+            type=int,
+            default=0,
+            help="Flash this many simulated devices in batch mode instead of probes",
+        )
+        self.parser.add_argument(
+            "--fake-delay",
+            type=float,
+            default=1.0,
+            help="Mean flashing time of a simulated device, s",
+        )
+        self.parser.add_argument(
+            "--fake-failure-rate",
+            type=float,
+            default=0.0,
+            help="Probability of a simulated flashing attempt to fail",
+        )
         self.parser.set_defaults(func=self.run)
 
     def get_faster_flash_cmdline(self, adapter) -> list[str]:
@@ -67,6 +116,9 @@ class Main(App):
         return []
 
     def run(self):
+        if self.args.batch:
+            return self.run_batch()
+
         signal.signal(signal.SIGINT, signal.SIG_IGN)
 
         mgr = GdbConfigurationManager()
@@ -95,6 +147,72 @@ class Main(App):
                 proc.terminate()
             return 1
 
+    def _discover_backends(self) -> list[FlashBackend]:
+        serials = None
+        if self.args.serial[0].upper() != "AUTO":
+            serials = self.args.serial[0].split(",")
+        interface = None
+        if self.args.interface in INTERFACES:
+            interface = INTERFACES[self.args.interface]
+
+        adapters = discover_all_probes(
+            self.args.platform, serials, interface, jobs=self.args.jobs
+        )
+        if not adapters:
+            self.logger.error("No debug adapters found")
+            return []
+        self.logger.info(f"Found {len(adapters)} adapters: {adapters}")
+        return [FlashBackend.for_adapter(adapter) for adapter in adapters]
+
+    def run_batch(self):
+        if not self.args.file:
+            self.logger.error("Firmware file is required")
+            return 1
+
+        if self.args.fake_devices:
+            FakeFlashBackend.reset_stats()
+            backends = [
+                FakeFlashBackend(
+                    f"fake{index}",
+                    delay=self.args.fake_delay,
+                    failure_rate=self.args.fake_failure_rate,
+                    seed=index,
+                )
+                for index in range(self.args.fake_devices)
+            ]
+        elif not (backends := self._discover_backends()):
+            return 1
+
+        flasher = BatchFlasher(
+            backends,
+            jobs=self.args.jobs,
+            retries=self.args.retries,
+            on_progress=lambda backend, line: self.logger.info(
+                f"[{backend.device_id}] {line}"
+            ),
+        )
+        results = flasher.run(
+            self.args.file,
+            self.args.verify,
+            on_result=lambda result: self.logger.log(
+                logging.INFO if result.success else logging.ERROR,
+                f"[{result.device}] {'OK' if result.success else 'FAILED'} "
+                f"in {result.duration:.1f}s",
+            ),
+        )
+
+        report = BatchFlasher.make_report(self.args.file, results)
+        if self.args.report:
+            with open(self.args.report, "w") as f:
+                json.dump(report, f, indent=2)
+        if self.args.fake_devices:
+            self.logger.info(
+                f"Simulated devices flashed concurrently: at most "
+                f"{FakeFlashBackend.max_active} of {self.args.jobs} jobs"
+            )
+        self.logger.info(f"Flashed {report['passed']} of {report['total']} devices")
+        return 0 if report["failed"] == 0 else 1
+
 
 if __name__ == "__main__":
     Main()()
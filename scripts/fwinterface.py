@@ -1,3 +1,4 @@
+import copy
 import enum
 import itertools
 import os
@@ -5,6 +6,7 @@ import shlex
 import socket
 import subprocess
 from abc import ABC, abstractmethod
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass
 from logging import getLogger
 from typing import Iterable, Optional
@@ -82,8 +84,9 @@ class OpenOCDTarget:
 class BaseInterface(ABC):
     COMMAND_NAME = "COMMAND_NAME"
 
-    def __init__(self, name):
+    def __init__(self, name, usb_port_pattern: Optional[str] = None):
         self.name = name
+        self.usb_port_pattern = usb_port_pattern
         self._serial = None
 
     @abstractmethod
@@ -107,12 +110,31 @@ class BaseInterface(ABC):
     def set_serial(self, serial):
         self._serial = serial
 
+    def enumerate_serials(self) -> list[str]:
+        """Serial numbers of attached adapters that expose a USB serial port"""
+        if not self.usb_port_pattern:
+            return []
+        return sorted(
+            set(
+                port.serial_number
+                for port in list_ports.grep(self.usb_port_pattern)
+                if port.serial_number
+            )
+        )
+
 
 class OpenOCDInterface(BaseInterface):
     COMMAND_NAME = "openocd"
 
-    def __init__(self, name, config_file, serial_command, transport_mode):
-        super().__init__(name)
+    def __init__(
+        self,
+        name,
+        config_file,
+        serial_command,
+        transport_mode,
+        usb_port_pattern: Optional[str] = None,
+    ):
+        super().__init__(name, usb_port_pattern)
         self.config_file = config_file
         self.serial_command = serial_command
         self.transport_mode = transport_mode
@@ -137,6 +159,21 @@ class OpenOCDInterface(BaseInterface):
             )
         return list(OpenOCDCommandLineParameter.to_args(params))
 
+    def no_server_args(self) -> list[str]:
+        """Disable listening ports, so concurrent OpenOCD instances don't clash"""
+        params = [
+            OpenOCDCommandLineParameter(
+                OpenOCDCommandLineParameter.Type.COMMAND,
+                param,
+            )
+            for param in (
+                "gdb_port disabled",
+                "telnet_port disabled",
+                "tcl_port disabled",
+            )
+        ]
+        return list(OpenOCDCommandLineParameter.to_args(params))
+
     def initial_args(self) -> list[str]:
         params = [
             OpenOCDCommandLineParameter(
@@ -149,7 +186,7 @@ class OpenOCDInterface(BaseInterface):
             ),
         ]
 
-        return list(OpenOCDCommandLineParameter.to_args(params))
+        return self.no_server_args() + list(OpenOCDCommandLineParameter.to_args(params))
 
     def connection_args(self) -> list[str]:
         connect_args = [
@@ -172,8 +209,8 @@ class OpenOCDInterface(BaseInterface):
 class BlackmagicInterface(BaseInterface):
     COMMAND_NAME = "arm-none-eabi-gdb"
 
-    def __init__(self, name):
-        super().__init__(name)
+    def __init__(self, name, usb_port_pattern: Optional[str] = None):
+        super().__init__(name, usb_port_pattern)
 
     def base_args(self) -> list[str]:
         gdb_launch_params = []
@@ -214,6 +251,7 @@ class BlackmagicInterface(BaseInterface):
 
 _BLACKMAGIC_USB = BlackmagicInterface(
     "blackmagic_usb",
+    "blackmagic",
 )
 _BLACKMAGIC_WIFI = BlackmagicInterface(
     "blackmagic_wifi",
@@ -223,6 +261,7 @@ __DAPLINK = OpenOCDInterface(
     "interface/cmsis-dap.cfg",
     "adapter serial",
     "swd",
+    "CMSIS-DAP|DAPLink",
 )
 
 __STLINK = OpenOCDInterface(
@@ -230,6 +269,7 @@ __STLINK = OpenOCDInterface(
     "interface/stlink.cfg",
     "adapter serial",
     "hla_swd",
+    "VID:PID=0483:37(48|4B|4E|4F|52|53)",
 )
 
 INTERFACES = dict(
@@ -402,8 +442,11 @@ def check_adapter(
 ):
     logger.debug(f"Checking {interface.name}, sn {serial_hint}")
     adapter_class = __interface_adapters.get(interface)
+    # Adapters keep their serial in the interface, so each one gets a copy
     adapter_to_check = adapter_class(
-        interface, OpenOCDTarget.for_platform(target_platform), serial_hint
+        copy.copy(interface),
+        OpenOCDTarget.for_platform(target_platform),
+        serial_hint,
     )
 
     if adapter_to_check.probe() is True:
@@ -427,3 +470,43 @@ def discover_probes(
                 break
 
     return adapters
+
+
+def discover_all_probes(
+    target_platform: FbtHardwarePlatform,
+    serials: Optional[list[str]] = None,
+    interface: OpenOCDInterface | BlackmagicInterface | None = None,
+    jobs: int = 8,
+) -> list[BaseAdapter]:
+    """Find every attached adapter, probing candidates concurrently.
+
+    Without explicit serials, candidates are enumerated from USB serial ports
+    of each interface. Adapters without a serial port (or network ones) must
+    be listed in serials.
+    """
+    interfaces_to_check = [interface] if interface is not None else INTERFACES.values()
+
+    candidates = [
+        (iface, serial)
+        for iface in interfaces_to_check
+        for serial in (serials if serials else iface.enumerate_serials())
+    ]
+    logger.debug(f"Probe candidates: {[(i.name, s) for i, s in candidates]}")
+
+    with ThreadPoolExecutor(max_workers=max(jobs, 1)) as pool:
+        probed = pool.map(
+            lambda candidate: check_adapter(
+                candidate[0], target_platform, serial_hint=candidate[1]
+            ),
+            candidates,
+        )
+        adapters = [adapter for adapter in probed if adapter]
+
+    # Same serial may answer on several interfaces, keep first match
+    seen_serials = set()
+    unique_adapters = []
+    for adapter in adapters:
+        if adapter.serial not in seen_serials:
+            seen_serials.add(adapter.serial)
+            unique_adapters.append(adapter)
+    return unique_adapters
@@ -0,0 +1,337 @@
+#!/usr/bin/env python3
+
+import struct
+import sys
+from collections import Counter, defaultdict
+from dataclasses import dataclass
+
+from flipper.app import App
+from flipper.utils.symbolizer import Symbolizer
+
+
+@dataclass
+class HeapTraceHeader:
+    # Mirrors FuriHalMemoryHeapTraceHeader from furi_hal_memory.h
+    MAGIC = 0x43525448
+    VERSION = 1
+    FORMAT = "<IBBHII"
+    SIZE = struct.calcsize(FORMAT)
+
+    pointer_size: int
+    event_size: int
+    tick_frequency: int
+    dropped: int = 0
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> "HeapTraceHeader":
+        magic, version, pointer_size, event_size, tick_frequency, dropped = (
+            struct.unpack_from(cls.FORMAT, data)
+        )
+        if magic != cls.MAGIC:
+            raise ValueError(f"Invalid heap trace magic 0x{magic:08x}")
+        if version != cls.VERSION:
+            raise ValueError(f"Unsupported heap trace version {version}")
+        if pointer_size not in (4, 8):
+            raise ValueError(f"Unsupported pointer size {pointer_size}")
+        return cls(pointer_size, event_size, tick_frequency, dropped)
+
+    def as_bytes(self) -> bytes:
+        return struct.pack(
+            self.FORMAT,
+            self.MAGIC,
+            self.VERSION,
+            self.pointer_size,
+            self.event_size,
+            self.tick_frequency,
+            self.dropped,
+        )
+
+    def event_format(self) -> str:
+        # FuriHalMemoryHeapTraceEvent with natural alignment of uintptr_t fields
+        if self.pointer_size == 8:
+            return "<B3xII4xQQQ"
+        return "<B3xIIIII"
+
+
+@dataclass
+class HeapTraceEvent:
+    TYPE_ALLOC = 1
+    TYPE_FREE = 2
+
+    type: int
+    tick: int
+    size: int
+    pointer: int
+    caller: int
+    thread: int
+
+
+def load_trace(data: bytes) -> tuple[HeapTraceHeader, list[HeapTraceEvent]]:
+    header = HeapTraceHeader.from_bytes(data)
+    event_struct = struct.Struct(header.event_format())
+    if event_struct.size != header.event_size:
+        raise ValueError(
+            f"Event size mismatch: stream {header.event_size}, expected {event_struct.size}"
+        )
+    payload = memoryview(data)[HeapTraceHeader.SIZE :]
+    if len(payload) % event_struct.size:
+        raise ValueError("Truncated heap trace stream")
+    events = [HeapTraceEvent(*fields) for fields in event_struct.iter_unpack(payload)]
+    return header, events
+
+
+class HeapReplay:
+    """Replays event stream, tracking live blocks and usage"""
+
+    def __init__(self, events: list[HeapTraceEvent]):
+        self.live: dict[int, HeapTraceEvent] = {}
+        self.in_use = 0
+        self.peak = 0
+        self.peak_tick = 0
+        self.unmatched_frees = 0
+        self.lost_frees = 0
+        self.events = events
+
+    def step(self, event: HeapTraceEvent):
+        if event.type == HeapTraceEvent.TYPE_ALLOC:
+            # Allocator can't hand out a live block: its free was lost to overflow
+            if block := self.live.get(event.pointer):
+                self.in_use -= block.size
+                self.lost_frees += 1
+            self.live[event.pointer] = event
+            self.in_use += event.size
+            if self.in_use > self.peak:
+                self.peak = self.in_use
+                self.peak_tick = event.tick
+        elif event.type == HeapTraceEvent.TYPE_FREE:
+            if block := self.live.pop(event.pointer, None):
+                self.in_use -= block.size
+            else:
+                # Allocated before tracking started or lost to overflow
+                self.unmatched_frees += 1
+
+    def run(self):
+        for event in self.events:
+            self.step(event)
+        return self
+
+
+class Main(App):
+    CLI_DRAIN_COMMAND = "heap_trace drain"
+
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_capture = self.subparsers.add_parser(
+            "capture", help="Drain heap trace ring buffer over CLI"
+        )
+        self.parser_capture.add_argument(
+            "-p", "--port", help="CDC Port", default="auto"
+        )
+        self.parser_capture.add_argument(
+            "-n", "--count", type=int, default=1, help="Number of drains to perform"
+        )
+        self.parser_capture.add_argument("output", help="Output stream file")
+        self.parser_capture.set_defaults(func=self.capture)
+
+        self.parser_timeline = self.subparsers.add_parser(
+            "timeline", help="Heap usage timeline"
+        )
+        self._add_common_args(self.parser_timeline)
+        self.parser_timeline.add_argument(
+            "--interval", type=int, default=1000, help="Bucket width in ticks"
+        )
+        self.parser_timeline.set_defaults(func=self.timeline)
+
+        self.parser_leaks = self.subparsers.add_parser(
+            "leaks", help="Blocks left allocated, grouped by caller"
+        )
+        self._add_common_args(self.parser_leaks)
+        self.parser_leaks.add_argument(
+            "--min-age",
+            type=int,
+            default=0,
+            help="Ignore blocks allocated less than this many ticks before stream end",
+        )
+        self.parser_leaks.set_defaults(func=self.leaks)
+
+        self.parser_flamegraph = self.subparsers.add_parser(
+            "flamegraph", help="Folded stacks for flamegraph.pl / speedscope"
+        )
+        self._add_common_args(self.parser_flamegraph)
+        self.parser_flamegraph.add_argument(
+            "--mode",
+            choices=("allocated", "live", "peak"),
+            default="allocated",
+            help="Total allocated bytes, bytes live at stream end or at peak usage",
+        )
+        self.parser_flamegraph.set_defaults(func=self.flamegraph)
+
+    def _add_common_args(self, parser):
+        parser.add_argument("stream", help="Heap trace stream file")
+        parser.add_argument("-e", "--elf", help="Firmware ELF for symbolization")
+        parser.add_argument(
+            "--addr2line",
+            default="arm-none-eabi-addr2line",
+            help="addr2line binary, use host one for host build streams",
+        )
+
+    def _load(self):
+        with open(self.args.stream, "rb") as f:
+            header, events = load_trace(f.read())
+        self.logger.info(
+            f"Loaded {len(events)} events, {header.pointer_size * 8}-bit producer"
+        )
+        if header.dropped:
+            self.logger.warning(
+                f"{header.dropped} events were dropped on overflow, results are approximate"
+            )
+        self.symbolizer = Symbolizer(self.args.elf, self.args.addr2line)
+        return header, events
+
+    def _caller_name(self, caller: int) -> str:
+        return str(
+            self.symbolizer.resolve(Symbolizer.return_address_to_call_site(caller))
+        )
+
+    def _resolve_callers(self, events):
+        self.symbolizer.resolve_many(
+            Symbolizer.return_address_to_call_site(e.caller) for e in events
+        )
+
+    def capture(self):
+        # Serial dependencies are only needed for capture
+        from flipper.storage import FlipperStorage
+        from flipper.utils.cdc import resolve_port
+        from flipper.utils.clidrain import CliDrainError, cli_drain
+
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+
+        header = None
+        events = bytearray()
+        with FlipperStorage(port) as cli:
+            for _ in range(self.args.count):
+                try:
+                    data = cli_drain(cli, self.CLI_DRAIN_COMMAND)
+                except CliDrainError as e:
+                    self.logger.error(f"Capture failed: {e}")
+                    return 1
+                chunk_header = HeapTraceHeader.from_bytes(data)
+                if header is None:
+                    header = chunk_header
+                else:
+                    header.dropped += chunk_header.dropped
+                events.extend(data[HeapTraceHeader.SIZE :])
+
+        with open(self.args.output, "wb") as f:
+            f.write(header.as_bytes())
+            f.write(events)
+        self.logger.info(
+            f"Captured {len(events) // header.event_size} events to {self.args.output}"
+        )
+        return 0
+
+    def timeline(self):
+        header, events = self._load()
+        replay = HeapReplay(events)
+        interval = self.args.interval
+
+        print(f"{'tick':>10} {'in use':>10} {'max':>10} {'allocs':>7} {'frees':>7}")
+        bucket_start = None
+        bucket_max = allocs = frees = 0
+        for event in events:
+            bucket = event.tick - event.tick % interval
+            if bucket_start is not None and bucket != bucket_start:
+                print(
+                    f"{bucket_start:>10} {replay.in_use:>10} {bucket_max:>10} {allocs:>7} {frees:>7}"
+                )
+                bucket_max = allocs = frees = 0
+            bucket_start = bucket
+            replay.step(event)
+            bucket_max = max(bucket_max, replay.in_use)
+            if event.type == HeapTraceEvent.TYPE_ALLOC:
+                allocs += 1
+            else:
+                frees += 1
+        if bucket_start is not None:
+            print(
+                f"{bucket_start:>10} {replay.in_use:>10} {bucket_max:>10} {allocs:>7} {frees:>7}"
+            )
+
+        seconds = (
+            replay.peak_tick / header.tick_frequency if header.tick_frequency else 0
+        )
+        print(f"Peak: {replay.peak} bytes at tick {replay.peak_tick} ({seconds:.3f}s)")
+        if replay.unmatched_frees:
+            print(f"Frees of untracked blocks: {replay.unmatched_frees}")
+        if replay.lost_frees:
+            print(f"Reallocated live blocks (lost frees): {replay.lost_frees}")
+        return 0
+
+    def leaks(self):
+        _, events = self._load()
+        replay = HeapReplay(events).run()
+        if not events:
+            return 0
+
+        end_tick = events[-1].tick
+        candidates = [
+            block
+            for block in replay.live.values()
+            if end_tick - block.tick >= self.args.min_age
+        ]
+        self._resolve_callers(candidates)
+
+        by_site = defaultdict(lambda: [0, 0, set()])
+        for block in candidates:
+            site = by_site[(self._caller_name(block.caller), block.thread)]
+            site[0] += 1
+            site[1] += block.size
+            site[2].add(block.size)
+
+        print(f"{'bytes':>10} {'blocks':>7}  {'thread':<10} caller")
+        for (caller, thread), (count, total, sizes) in sorted(
+            by_site.items(), key=lambda item: item[1][1], reverse=True
+        ):
+            size_hint = f" [{min(sizes)}..{max(sizes)}]" if len(sizes) > 1 else ""
+            print(f"{total:>10} {count:>7}  0x{thread:08x} {caller}{size_hint}")
+        print(
+            f"Total: {sum(b.size for b in candidates)} bytes in {len(candidates)} blocks"
+        )
+        return 0
+
+    def flamegraph(self):
+        _, events = self._load()
+        if self.args.mode == "allocated":
+            blocks = [e for e in events if e.type == HeapTraceEvent.TYPE_ALLOC]
+        elif self.args.mode == "live":
+            blocks = list(HeapReplay(events).run().live.values())
+        else:
+            blocks = self._peak_blocks(events)
+        self._resolve_callers(blocks)
+
+        folded = Counter()
+        for block in blocks:
+            folded[
+                f"0x{block.thread:08x};{self._caller_name(block.caller)}"
+            ] += block.size
+        for stack, size in folded.most_common():
+            sys.stdout.write(f"{stack} {size}\n")
+        return 0
+
+    @staticmethod
+    def _peak_blocks(events) -> list[HeapTraceEvent]:
+        # Peak is known only after full replay, so replay twice
+        peak = HeapReplay(events).run().peak
+        replay = HeapReplay(events)
+        for event in events:
+            replay.step(event)
+            if replay.in_use == peak:
+                break
+        return list(replay.live.values())
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+
+import struct
+import xml.etree.ElementTree as ET
+from dataclasses import dataclass
+
+from flipper.app import App
+from flipper.utils.hw_platform import FbtHardwarePlatform
+
+
+@dataclass
+class InterruptStatsHeader:
+    # Mirrors FuriHalInterruptStatsHeader from furi_hal_interrupt.h
+    MAGIC = 0x53515249
+    VERSION = 2
+    FORMAT = "<IBBHIIHH"
+    SIZE = struct.calcsize(FORMAT)
+
+    histogram_size: int
+    record_size: int
+    cycles_per_us: int
+    elapsed_ms: int
+    record_count: int
+    names_size: int
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> "InterruptStatsHeader":
+        magic, version, *fields = struct.unpack_from(cls.FORMAT, data)
+        if magic != cls.MAGIC:
+            raise ValueError(f"Invalid interrupt stats magic 0x{magic:08x}")
+        if version != cls.VERSION:
+            raise ValueError(f"Unsupported interrupt stats version {version}")
+        return cls(*fields)
+
+    def record_format(self) -> str:
+        # FuriHalInterruptStats, padded to uint64_t alignment
+        fmt = f"<QIIB3x{self.histogram_size}I"
+        padding = -struct.calcsize(fmt) % 8
+        return fmt + (f"{padding}x" if padding else "")
+
+
+@dataclass
+class InterruptStats:
+    cycles_total: int
+    count: int
+    cycles_max: int
+    exception_number: int
+    histogram: tuple[int, ...]
+    # furi_hal_interrupt_get_name() on device, None if unknown
+    name: str | None = None
+
+
+def load_stats(data: bytes) -> tuple[InterruptStatsHeader, list[InterruptStats]]:
+    header = InterruptStatsHeader.from_bytes(data)
+    record_struct = struct.Struct(header.record_format())
+    if record_struct.size != header.record_size:
+        raise ValueError(
+            f"Record size mismatch: stream {header.record_size}, expected {record_struct.size}"
+        )
+    records_end = InterruptStatsHeader.SIZE + header.record_count * record_struct.size
+    if len(data) != records_end + header.names_size:
+        raise ValueError(
+            f"Stream size mismatch: got {len(data)}, "
+            f"expected {records_end + header.names_size}"
+        )
+    names = data[records_end:].split(b"\0")[: header.record_count]
+    if len(names) != header.record_count:
+        raise ValueError(f"Name table has {len(names)} of {header.record_count} names")
+    records = [
+        InterruptStats(*fields[:4], fields[4:], name.decode("utf-8") or None)
+        for fields, name in zip(
+            record_struct.iter_unpack(
+                memoryview(data)[InterruptStatsHeader.SIZE : records_end]
+            ),
+            names,
+        )
+    ]
+    return header, records
+
+
+class InterruptNames:
+    # Fallback for records device could not name: Cortex-M system exceptions,
+    # device IRQs from SVD if one is given
+    SYSTEM_EXCEPTIONS = {
+        2: "NMI",
+        3: "HardFault",
+        4: "MemManage",
+        5: "BusFault",
+        6: "UsageFault",
+        11: "SVCall",
+        12: "DebugMonitor",
+        14: "PendSV",
+        15: "SysTick",
+    }
+    IRQ_OFFSET = 16
+
+    def __init__(self, svd_file: str | None):
+        self.names = dict(self.SYSTEM_EXCEPTIONS)
+        if svd_file:
+            for interrupt in ET.parse(svd_file).iter("interrupt"):
+                irq = int(interrupt.findtext("value"), 0)
+                self.names[irq + self.IRQ_OFFSET] = interrupt.findtext("name")
+
+    def __getitem__(self, record: InterruptStats) -> str:
+        if record.name:
+            return record.name
+        if name := self.names.get(record.exception_number):
+            return name
+        return f"IRQ{record.exception_number - self.IRQ_OFFSET}"
+
+
+class Main(App):
+    CLI_DRAIN_COMMAND = "irq_stats"
+    HISTOGRAM_BAR = " ▁▂▃▄▅▆▇█"
+
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_capture = self.subparsers.add_parser(
+            "capture", help="Get interrupt statistics snapshot over CLI"
+        )
+        self.parser_capture.add_argument(
+            "-p", "--port", help="CDC Port", default="auto"
+        )
+        self.parser_capture.add_argument(
+            "--reset", action="store_true", help="Reset statistics after snapshot"
+        )
+        self.parser_capture.add_argument("output", help="Output snapshot file")
+        self.parser_capture.set_defaults(func=self.capture)
+
+        self.parser_show = self.subparsers.add_parser(
+            "show", help="Render interrupt statistics table"
+        )
+        self.parser_show.add_argument("snapshot", help="Snapshot file")
+        self.parser_show.add_argument(
+            "--svd", help="SVD file for IRQs not named by device"
+        )
+        self.parser_show.add_argument(
+            "-p",
+            "--platform",
+            help="Platform description JSON, provides SVD if --svd is not given",
+            type=FbtHardwarePlatform.from_file,
+        )
+        self.parser_show.add_argument(
+            "--sort",
+            choices=("total", "max", "count"),
+            default="total",
+            help="Sort order",
+        )
+        self.parser_show.add_argument(
+            "--all", action="store_true", help="Show interrupts that never fired"
+        )
+        self.parser_show.set_defaults(func=self.show)
+
+    def capture(self):
+        # Serial dependencies are only needed for capture
+        from flipper.storage import FlipperStorage
+        from flipper.utils.cdc import resolve_port
+        from flipper.utils.clidrain import CliDrainError, cli_drain
+
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+
+        command = self.CLI_DRAIN_COMMAND + (" reset" if self.args.reset else "")
+        try:
+            with FlipperStorage(port) as cli:
+                data = cli_drain(cli, command)
+        except CliDrainError as e:
+            self.logger.error(f"Capture failed: {e}")
+            return 1
+        load_stats(data)
+
+        with open(self.args.output, "wb") as f:
+            f.write(data)
+        self.logger.info(f"Saved snapshot to {self.args.output}")
+        return 0
+
+    def _histogram_sparkline(self, histogram) -> str:
+        peak = max(histogram)
+        if not peak:
+            return ""
+        steps = len(self.HISTOGRAM_BAR) - 1
+        return "".join(
+            self.HISTOGRAM_BAR[-(-bucket * steps // peak)] for bucket in histogram
+        )
+
+    def _svd_file(self) -> str | None:
+        if self.args.svd:
+            return self.args.svd
+        if self.args.platform and self.args.platform.svd_file:
+            return str(self.args.platform.svd_file)
+        return None
+
+    def show(self):
+        with open(self.args.snapshot, "rb") as f:
+            header, records = load_stats(f.read())
+        names = InterruptNames(self._svd_file())
+        scale = header.cycles_per_us or 1
+        elapsed_us = header.elapsed_ms * 1000
+
+        if not self.args.all:
+            records = [r for r in records if r.count]
+        sort_keys = {
+            "total": lambda r: r.cycles_total,
+            "max": lambda r: r.cycles_max,
+            "count": lambda r: r.count,
+        }
+        records.sort(key=sort_keys[self.args.sort], reverse=True)
+
+        print(
+            f"{'interrupt':<24} {'count':>10} {'total us':>12} {'avg us':>9} {'max us':>9} {'load %':>7}  histogram (2^N clocks)"
+        )
+        for record in records:
+            total_us = record.cycles_total / scale
+            avg_us = total_us / record.count if record.count else 0
+            load = total_us * 100 / elapsed_us if elapsed_us else 0
+            print(
+                f"{names[record]:<24} {record.count:>10} "
+                f"{total_us:>12.1f} {avg_us:>9.2f} {record.cycles_max / scale:>9.2f} "
+                f"{load:>7.3f}  |{self._histogram_sparkline(record.histogram)}|"
+            )
+
+        total_us = sum(r.cycles_total for r in records) / scale
+        print(f"Window: {header.elapsed_ms} ms, total in ISR: {total_us:.1f} us")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
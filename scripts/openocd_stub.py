@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+
+import random
+import time
+
+from flipper.app import App
+from flipper.utils.openocd import OpenOCD
+from flipper.utils.openocd_stub import OpenOCDStub
+
+
+class Main(App):
+    SRAM_BASE = 0x20000000
+
+    def init(self):
+        self.parser.add_argument(
+            "--latency", help="Reply latency, ms", type=float, default=2.0
+        )
+        self.parser.add_argument(
+            "--command-time",
+            help="Execution time per command, ms",
+            type=float,
+            default=0,
+        )
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_serve = self.subparsers.add_parser(
+            "serve", help="Serve emulated TCL RPC until interrupted"
+        )
+        self.parser_serve.add_argument(
+            "-p", "--port", help="TCL port", type=int, default=6666
+        )
+        self.parser_serve.set_defaults(func=self.serve)
+
+        self.parser_check = self.subparsers.add_parser(
+            "check", help="Check and time OpenOCD block access against the stub"
+        )
+        self.parser_check.add_argument(
+            "--words", help="Block transfer size, words", type=int, default=600
+        )
+        self.parser_check.add_argument(
+            "--reads", help="Single word reads to time", type=int, default=100
+        )
+        self.parser_check.add_argument("--seed", type=int, default=0)
+        self.parser_check.set_defaults(func=self.check)
+
+    def _stub(self, port: int = 0) -> OpenOCDStub:
+        return OpenOCDStub(
+            latency=self.args.latency / 1000,
+            command_time=self.args.command_time / 1000,
+            port=port,
+        )
+
+    def serve(self):
+        stub = self._stub(self.args.port)
+        self.logger.info(
+            f"Listening on port {stub.port} for tcl connections, "
+            f"latency {self.args.latency} ms"
+        )
+        try:
+            stub.serve_forever()
+        except KeyboardInterrupt:
+            pass
+        self.logger.info(f"Served {stub.commands} commands")
+        return 0
+
+    def _timed(self, name: str, stub: OpenOCDStub, call):
+        commands = stub.commands
+        start = time.monotonic()
+        result = call()
+        elapsed = (time.monotonic() - start) * 1000
+        print(f"{name:<40} {elapsed:9.1f} ms  {stub.commands - commands:5} commands")
+        return result
+
+    def check(self):
+        rng = random.Random(self.args.seed)
+        words = [rng.getrandbits(32) for _ in range(self.args.words)]
+        scattered = [
+            (self.SRAM_BASE + 0x10000 + rng.randrange(0x1000) * 4, rng.getrandbits(32))
+            for _ in range(64)
+        ]
+        errors = []
+
+        with self._stub() as stub:
+            openocd = OpenOCD()
+            openocd.tcl_port = stub.port
+            openocd.connect()
+
+            self._timed(
+                f"write_block_32 {len(words)} words",
+                stub,
+                lambda: openocd.write_block_32(self.SRAM_BASE, words),
+            )
+            if stub.memory.read(self.SRAM_BASE, len(words)) != words:
+                errors.append("write_block_32: target memory differs")
+            if (
+                self._timed(
+                    f"read_block_32 {len(words)} words",
+                    stub,
+                    lambda: openocd.read_block_32(self.SRAM_BASE, len(words)),
+                )
+                != words
+            ):
+                errors.append("read_block_32: data differs")
+
+            self._timed(
+                f"write_32_many {len(scattered)} writes",
+                stub,
+                lambda: openocd.write_32_many(scattered),
+            )
+            expected = dict(scattered)
+            for addr, value in expected.items():
+                if stub.memory.read(addr, 1)[0] != value:
+                    errors.append(f"write_32_many: 0x{addr:08x} differs")
+                    break
+
+            reads = self.args.reads
+            serial = self._timed(
+                f"read_32 x{reads}",
+                stub,
+                lambda: [openocd.read_32(self.SRAM_BASE + i * 4) for i in range(reads)],
+            )
+            pipelined = self._timed(
+                f"send_tcl_pipelined mdw x{reads}",
+                stub,
+                lambda: openocd.send_tcl_pipelined(
+                    [f"mdw 0x{self.SRAM_BASE + i * 4:08x}" for i in range(reads)]
+                ),
+            )
+            pipelined = [int(reply.split(": ")[-1], 16) for reply in pipelined]
+            if serial != words[:reads] or pipelined != words[:reads]:
+                errors.append("read_32/send_tcl_pipelined: replies out of order")
+
+            try:
+                openocd.read_block_32(0x10000000, 4)
+                errors.append("read_block_32: read outside memory map succeeded")
+            except Exception:
+                pass
+
+            openocd.send_tcl("exit")
+            openocd.socket.close()
+
+        for error in errors:
+            self.logger.error(error)
+        return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    Main()()
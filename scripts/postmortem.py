@@ -0,0 +1,552 @@
+#!/usr/bin/env python3
+
+import json
+from dataclasses import asdict, dataclass, field
+from typing import Optional
+
+from flipper.app import App
+from flipper.utils.dwarf import DebugImage, DumpReadError, DwarfInfo, MemoryImage, Value
+from flipper.utils.hw_platform import FbtHardwarePlatform
+
+
+@dataclass
+class TaskState:
+    name: str
+    tcb: int
+    state: str
+    priority: int
+    base_priority: Optional[int]
+    stack_base: int
+    stack_top: int
+    stack_size: Optional[int]
+    stack_used: Optional[int]
+    stack_high_water: Optional[int]
+    waits_on: Optional[str] = None
+
+
+@dataclass
+class QueueState:
+    name: str
+    handle: int
+    kind: str
+    messages: int
+    length: int
+    item_size: int
+    holder: Optional[str] = None
+    waiting_send: list[str] = field(default_factory=list)
+    waiting_receive: list[str] = field(default_factory=list)
+
+
+@dataclass
+class HeapState:
+    start: int
+    end: int
+    used_blocks: int
+    used_bytes: int
+    free_blocks: int
+    free_bytes: int
+    largest_free: int
+    free_bytes_remaining: Optional[int]
+    minimum_ever_free: Optional[int]
+    corrupted_at: Optional[int] = None
+
+
+@dataclass
+class PoolState:
+    start: int
+    free: int
+
+
+@dataclass
+class AppState:
+    name: str
+    entry: int
+    text_address: Optional[int]
+    debug_link_elf: Optional[str]
+    sections: dict[str, int] = field(default_factory=dict)
+
+
+class FreeRtosDecoder:
+    """Rebuilds FreeRTOS kernel state from a RAM dump.
+
+    Uses the same structures as FreeRTOSgdb, but reads each object in one go
+    from the dump instead of a gdb round trip per field.
+    """
+
+    STACK_FILL_BYTE = 0xA5
+    LIST_ITEMS_MAX = 256
+    QUEUE_KINDS = {
+        0: "queue",
+        1: "mutex",
+        2: "counting",
+        3: "binary",
+        4: "recursive",
+    }
+
+    def __init__(self, image: DebugImage):
+        self.image = image
+        self.tcb_type = image.variable("pxCurrentTCB").deref().type_ref
+        # Event list container -> object label, filled by queues()
+        self.wait_objects: dict[int, str] = {}
+
+    def walk_list(self, list_value: Value):
+        """Yield TCB values owned by List_t items"""
+        list_end = list_value["xListEnd"].address
+        item_pointer = list_value["xListEnd"]["pxNext"]
+        for _ in range(min(int(list_value["uxNumberOfItems"]), self.LIST_ITEMS_MAX)):
+            if int(item_pointer) == list_end:
+                break
+            item = item_pointer.deref()
+            yield self.image.value(self.tcb_type, int(item["pvOwner"]))
+            item_pointer = item["pxNext"]
+
+    def _state_lists(self):
+        ready_lists = self.image.variable("pxReadyTasksLists")
+        for priority in range(len(ready_lists)):
+            yield "ready", ready_lists[priority]
+        for name, state in (
+            ("xDelayedTaskList1", "blocked"),
+            ("xDelayedTaskList2", "blocked"),
+            ("xSuspendedTaskList", "suspended"),
+            ("xTasksWaitingTermination", "deleted"),
+        ):
+            if self.image.has_variable(name):
+                yield state, self.image.variable(name)
+
+    def _stack_high_water(self, stack_base: int, limit: int) -> Optional[int]:
+        # Same as prvTaskCheckFreeStackSpace: count untouched fill bytes
+        memory = self.image.image
+        if not memory.contains(stack_base, limit):
+            return None
+        data = memory.read(stack_base, limit)
+        return len(data) - len(data.lstrip(bytes((self.STACK_FILL_BYTE,))))
+
+    def _task(self, tcb: Value, state: str) -> TaskState:
+        stack_base = int(tcb["pxStack"])
+        stack_top = int(tcb["pxTopOfStack"])
+        stack_size = stack_used = None
+        if tcb.has_member("pxEndOfStack"):
+            # pxEndOfStack points to the last stack word
+            end_of_stack = tcb["pxEndOfStack"]
+            stack_end = int(end_of_stack) + self.image.info.sizeof(
+                end_of_stack.die.target
+            )
+            stack_size = stack_end - stack_base
+            stack_used = stack_end - stack_top
+        scan_limit = stack_size if stack_size else max(stack_top - stack_base, 0)
+
+        waits_on = None
+        if state in ("blocked", "suspended") and (
+            container := int(tcb["xEventListItem"]["pvContainer"])
+        ):
+            waits_on = self.wait_objects.get(container, f"0x{container:08x}")
+        if state == "suspended" and waits_on:
+            # Blocking without timeout parks task in suspended list
+            state = "blocked"
+
+        return TaskState(
+            name=tcb["pcTaskName"].string(),
+            tcb=tcb.address,
+            state=state,
+            priority=int(tcb["uxPriority"]),
+            base_priority=(
+                int(tcb["uxBasePriority"]) if tcb.has_member("uxBasePriority") else None
+            ),
+            stack_base=stack_base,
+            stack_top=stack_top,
+            stack_size=stack_size,
+            stack_used=stack_used,
+            stack_high_water=self._stack_high_water(stack_base, scan_limit),
+            waits_on=waits_on,
+        )
+
+    def tasks(self) -> list[TaskState]:
+        current = int(self.image.variable("pxCurrentTCB"))
+        tasks = {}
+        for state, list_value in self._state_lists():
+            for tcb in self.walk_list(list_value):
+                tasks.setdefault(
+                    tcb.address,
+                    self._task(tcb, "running" if tcb.address == current else state),
+                )
+        if current and current not in tasks:
+            tasks[current] = self._task(
+                self.image.value(self.tcb_type, current), "running"
+            )
+        return sorted(tasks.values(), key=lambda task: (-task.priority, task.name))
+
+    def _task_names(self, list_value: Value) -> list[str]:
+        return [tcb["pcTaskName"].string() for tcb in self.walk_list(list_value)]
+
+    def queues(self) -> list[QueueState]:
+        if not self.image.has_variable("xQueueRegistry"):
+            return []
+        registry = self.image.variable("xQueueRegistry")
+        queues = []
+        for index in range(len(registry)):
+            entry = registry[index]
+            if not (handle := entry["xHandle"]):
+                continue
+            name = entry["pcQueueName"].string() if entry["pcQueueName"] else "?"
+            queue = handle.deref()
+
+            kind = "queue"
+            if queue.has_member("ucQueueType"):
+                kind = self.QUEUE_KINDS.get(int(queue["ucQueueType"]), "unknown")
+            holder = None
+            if (
+                kind in ("mutex", "recursive")
+                and queue.has_member("u")
+                and (holder_tcb := queue["u"]["xSemaphore"]["xMutexHolder"])
+            ):
+                holder = self.image.value(self.tcb_type, int(holder_tcb))[
+                    "pcTaskName"
+                ].string()
+
+            for list_name, label in (
+                ("xTasksWaitingToSend", "send"),
+                ("xTasksWaitingToReceive", "take" if kind != "queue" else "receive"),
+            ):
+                self.wait_objects[queue[list_name].address] = f"{name} ({label})"
+
+            queues.append(
+                QueueState(
+                    name=name,
+                    handle=queue.address,
+                    kind=kind,
+                    messages=int(queue["uxMessagesWaiting"]),
+                    length=int(queue["uxLength"]),
+                    item_size=int(queue["uxItemSize"]),
+                    holder=holder,
+                    waiting_send=self._task_names(queue["xTasksWaitingToSend"]),
+                    waiting_receive=self._task_names(queue["xTasksWaitingToReceive"]),
+                )
+            )
+        return queues
+
+
+class HeapDecoder:
+    """Walks heap_4 style allocator used by memmgr_heap.c"""
+
+    BYTE_ALIGNMENT = 8
+    FREE_BLOCKS_MAX = 4096
+
+    def __init__(self, image: DebugImage):
+        self.image = image
+
+    def _heap_bounds(self) -> tuple[int, int]:
+        if (start := self.image.symbol_address("__heap_start__")) is None:
+            heap = self.image.variable("ucHeap")
+            start = int(heap) if heap.die.tag == "DW_TAG_pointer_type" else heap.address
+        start = -(-start // self.BYTE_ALIGNMENT) * self.BYTE_ALIGNMENT
+        return start, int(self.image.variable("pxEnd"))
+
+    def _optional(self, name: str) -> Optional[int]:
+        return int(self.image.variable(name)) if self.image.has_variable(name) else None
+
+    def decode(self) -> HeapState:
+        start, end = self._heap_bounds()
+        block_type = self.image.variable("xStart").type_ref
+        header_size = self.image.info.sizeof(block_type)
+        size_member = self.image.info.find_member(block_type, "xBlockSize")
+        size_bits = self.image.info.sizeof(size_member.type) * 8
+        allocated_bit = self._optional("xBlockAllocatedBit") or 1 << (size_bits - 1)
+
+        state = HeapState(start, end, 0, 0, 0, 0, 0, None, None)
+        state.free_bytes_remaining = self._optional("xFreeBytesRemaining")
+        state.minimum_ever_free = self._optional("xMinimumEverFreeBytesRemaining")
+
+        address = start
+        while address < end:
+            block_size = int(self.image.value(block_type, address)["xBlockSize"])
+            size = block_size & ~allocated_bit
+            if size < header_size or address + size > end:
+                state.corrupted_at = address
+                break
+            if block_size & allocated_bit:
+                state.used_blocks += 1
+                state.used_bytes += size
+            else:
+                state.free_blocks += 1
+                state.free_bytes += size
+                state.largest_free = max(state.largest_free, size)
+            address += size
+        return state
+
+    def free_list(self) -> list[tuple[int, int]]:
+        blocks = []
+        end = int(self.image.variable("pxEnd"))
+        block = self.image.variable("xStart")["pxNextFreeBlock"]
+        while int(block) and int(block) != end and len(blocks) < self.FREE_BLOCKS_MAX:
+            blocks.append((int(block), int(block.deref()["xBlockSize"])))
+            block = block.deref()["pxNextFreeBlock"]
+        return blocks
+
+
+def decode_pools(image: DebugImage) -> list[PoolState]:
+    # furi_hal_memory.c bump allocator over SRAM2 leftovers
+    if not image.has_variable("furi_hal_memory"):
+        return []
+    if not (memory := image.variable("furi_hal_memory")):
+        return []
+    regions = memory.deref()["region"]
+    return [
+        PoolState(int(regions[index]["start"]), int(regions[index]["size"]))
+        for index in range(len(regions))
+    ]
+
+
+def decode_apps(image: DebugImage) -> list[AppState]:
+    # Same list as flipperapps.py walks in live gdb session
+    app_list = image.variable("flipper_application_loaded_app_list")
+    node = app_list[0] if app_list.die.tag == "DW_TAG_array_type" else app_list
+    apps = []
+    visited = set()
+    while node and int(node) not in visited:
+        visited.add(int(node))
+        entry = node.deref()
+        if app_pointer := entry["data"]:
+            app = app_pointer.deref()
+            state = app["state"]
+            sections = {}
+            for index in range(int(state["mmap_entry_count"])):
+                mmap_entry = state["mmap_entries"][index]
+                sections[mmap_entry["name"].string()] = int(mmap_entry["address"])
+
+            debug_link_elf = None
+            debug_link = state["debug_link_info"]
+            if debug_link_size := int(debug_link["debug_link_size"]):
+                data = image.image.read(int(debug_link["debug_link"]), debug_link_size)
+                # Null-terminated name padded to 4 bytes, followed by CRC32
+                debug_link_elf = data[:-4].decode("utf-8").split("\x00")[0]
+
+            apps.append(
+                AppState(
+                    name=app["manifest"]["name"].string(),
+                    entry=int(state["entry"]),
+                    text_address=sections.pop(".text", None),
+                    debug_link_elf=debug_link_elf,
+                    sections=sections,
+                )
+            )
+        node = entry["next"]
+    return apps
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_tasks = self.subparsers.add_parser(
+            "tasks", help="Task list with states and stack usage"
+        )
+        self._add_common_args(self.parser_tasks)
+        self.parser_tasks.set_defaults(func=self.tasks)
+
+        self.parser_queues = self.subparsers.add_parser(
+            "queues", help="Registered queues, semaphores and mutexes"
+        )
+        self._add_common_args(self.parser_queues)
+        self.parser_queues.set_defaults(func=self.queues)
+
+        self.parser_heap = self.subparsers.add_parser(
+            "heap", help="Heap and memory pool usage"
+        )
+        self._add_common_args(self.parser_heap)
+        self.parser_heap.add_argument(
+            "--free-list", action="store_true", help="Dump heap free list"
+        )
+        self.parser_heap.set_defaults(func=self.heap)
+
+        self.parser_apps = self.subparsers.add_parser(
+            "apps", help="Loaded external applications"
+        )
+        self._add_common_args(self.parser_apps)
+        self.parser_apps.set_defaults(func=self.apps)
+
+        self.parser_report = self.subparsers.add_parser(
+            "report", help="All of the above"
+        )
+        self._add_common_args(self.parser_report)
+        self.parser_report.add_argument(
+            "--json", help="Also save report as JSON", default=None
+        )
+        self.parser_report.set_defaults(func=self.report)
+
+    def _add_common_args(self, parser):
+        parser.add_argument("elf", help="Firmware ELF with debug info")
+        parser.add_argument(
+            "dump",
+            nargs="+",
+            help="Raw memory dump as FILE[@ADDRESS], e.g. from OpenOCD dump_image",
+        )
+        parser.add_argument(
+            "-p",
+            "--platform",
+            help="Platform file, ram_address is default dump address",
+            type=FbtHardwarePlatform.from_file,
+            default=None,
+        )
+        parser.add_argument(
+            "--readelf", help="readelf binary", default="arm-none-eabi-readelf"
+        )
+
+    def before(self):
+        memory = MemoryImage()
+        for dump in self.args.dump:
+            path, _, address = dump.partition("@")
+            if address:
+                base = int(address, 0)
+            elif self.args.platform:
+                base = self.args.platform.ram_address
+            else:
+                self.parser.error(f"No address for {path}, pass FILE@ADDRESS or -p")
+            memory.add_file(base, path)
+        # Dump wins on overlap, flash contents come from the ELF itself
+        memory.add_elf_sections(self.args.elf)
+
+        self.logger.debug(f"Loading debug info from {self.args.elf}")
+        self.image = DebugImage(DwarfInfo(self.args.elf, self.args.readelf), memory)
+
+    def _section(self, title: str, decode):
+        try:
+            return decode()
+        except (KeyError, TypeError, DumpReadError) as e:
+            self.logger.error(f"Failed to decode {title}: {e}")
+            return None
+
+    @staticmethod
+    def _size(value: Optional[int]) -> str:
+        return "-" if value is None else str(value)
+
+    def _print_tasks(self, tasks: list[TaskState]):
+        print(
+            f"{'name':<20} {'tcb':>10} {'state':<10} {'prio':>5} {'stack':>6} {'used':>6} {'hwm':>6}  waits on"
+        )
+        for task in tasks:
+            priority = str(task.priority)
+            if task.base_priority is not None and task.base_priority != task.priority:
+                priority += f"/{task.base_priority}"
+            overflow = " OVERFLOW" if task.stack_top < task.stack_base else ""
+            print(
+                f"{task.name:<20} {task.tcb:>#10x} {task.state:<10} {priority:>5} "
+                f"{self._size(task.stack_size):>6} {self._size(task.stack_used):>6} "
+                f"{self._size(task.stack_high_water):>6}  {task.waits_on or ''}{overflow}"
+            )
+
+    def _print_queues(self, queues: list[QueueState]):
+        print(
+            f"{'name':<20} {'handle':>10} {'kind':<10} {'msgs':>9} {'item':>5}  waiting"
+        )
+        for queue in queues:
+            waiting = [f"tx:{name}" for name in queue.waiting_send] + [
+                f"rx:{name}" for name in queue.waiting_receive
+            ]
+            if queue.holder:
+                waiting.insert(0, f"held by {queue.holder}")
+            print(
+                f"{queue.name:<20} {queue.handle:>#10x} {queue.kind:<10} "
+                f"{f'{queue.messages}/{queue.length}':>9} {queue.item_size:>5}  "
+                + ", ".join(waiting)
+            )
+
+    def _print_heap(self, heap: HeapState, pools: list[PoolState]):
+        total = heap.end - heap.start
+        print(f"Heap 0x{heap.start:08x}-0x{heap.end:08x}, {total} bytes")
+        print(f"  Used: {heap.used_bytes} bytes in {heap.used_blocks} blocks")
+        print(f"  Free: {heap.free_bytes} bytes in {heap.free_blocks} blocks")
+        if heap.free_bytes:
+            fragmentation = 100 - heap.largest_free * 100 / heap.free_bytes
+            print(
+                f"  Largest free block: {heap.largest_free}, fragmentation {fragmentation:.1f}%"
+            )
+        print(
+            f"  Allocator counters: free {self._size(heap.free_bytes_remaining)}, "
+            f"minimum ever {self._size(heap.minimum_ever_free)}"
+        )
+        if heap.corrupted_at is not None:
+            print(f"  Heap corrupted, walk stopped at 0x{heap.corrupted_at:08x}")
+        elif (
+            heap.free_bytes_remaining is not None
+            and heap.free_bytes_remaining != heap.free_bytes
+        ):
+            print("  Free bytes mismatch between block walk and allocator counter")
+        for pool in pools:
+            print(f"Pool 0x{pool.start:08x}: {pool.free} bytes free")
+
+    def _print_apps(self, apps: list[AppState]):
+        print(f"{'name':<24} {'entry':>10} {'.text':>10}  debug link")
+        for app in apps:
+            text_address = "-" if app.text_address is None else f"{app.text_address:#x}"
+            print(
+                f"{app.name:<24} {app.entry:>#10x} {text_address:>10}  {app.debug_link_elf or ''}"
+            )
+
+    def _decode_freertos(self):
+        if not (rtos := self._section("kernel", lambda: FreeRtosDecoder(self.image))):
+            return [], []
+        # Queues first, they label objects tasks are blocked on
+        queues = self._section("queues", rtos.queues) or []
+        return self._section("tasks", rtos.tasks) or [], queues
+
+    def tasks(self):
+        tasks, _ = self._decode_freertos()
+        self._print_tasks(tasks)
+        return 0
+
+    def queues(self):
+        _, queues = self._decode_freertos()
+        self._print_queues(queues)
+        return 0
+
+    def heap(self):
+        decoder = HeapDecoder(self.image)
+        if not (heap := self._section("heap", decoder.decode)):
+            return 1
+        pools = self._section("pools", lambda: decode_pools(self.image)) or []
+        self._print_heap(heap, pools)
+        if self.args.free_list:
+            for address, size in decoder.free_list():
+                print(f"  free 0x{address:08x} {size}")
+        return 0
+
+    def apps(self):
+        apps = self._section("apps", lambda: decode_apps(self.image))
+        if apps is None:
+            return 1
+        self._print_apps(apps)
+        return 0
+
+    def report(self):
+        tasks, queues = self._decode_freertos()
+        heap = self._section("heap", HeapDecoder(self.image).decode)
+        pools = self._section("pools", lambda: decode_pools(self.image)) or []
+        apps = self._section("apps", lambda: decode_apps(self.image)) or []
+
+        self._print_tasks(tasks)
+        print()
+        self._print_queues(queues)
+        print()
+        if heap:
+            self._print_heap(heap, pools)
+            print()
+        self._print_apps(apps)
+
+        if self.args.json:
+            with open(self.args.json, "w") as f:
+                json.dump(
+                    {
+                        "tasks": [asdict(task) for task in tasks],
+                        "queues": [asdict(queue) for queue in queues],
+                        "heap": asdict(heap) if heap else None,
+                        "pools": [asdict(pool) for pool in pools],
+                        "apps": [asdict(app) for app in apps],
+                    },
+                    f,
+                    indent=2,
+                )
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+
+import json
+import math
+import struct
+from collections import defaultdict
+from dataclasses import dataclass
+
+from flipper.app import App
+
+
+@dataclass
+class ProfileHeader:
+    # Mirrors FuriHalProfileHeader from furi_hal_profile.h
+    MAGIC = 0x464F5250
+    VERSION = 3
+    FORMAT = "<IBBHB3xII"
+    SIZE = struct.calcsize(FORMAT)
+    # Contexts below are IPSR exception numbers, above are thread IDs
+    CONTEXT_ISR_LIMIT = 0x200
+
+    core_count: int
+    event_size: int
+    pointer_size: int
+    cycles_per_us: int
+    dropped: int = 0
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> "ProfileHeader":
+        magic, version, *fields = struct.unpack_from(cls.FORMAT, data)
+        if magic != cls.MAGIC:
+            raise ValueError(f"Invalid profile stream magic 0x{magic:08x}")
+        if version != cls.VERSION:
+            raise ValueError(f"Unsupported profile stream version {version}")
+        header = cls(*fields)
+        if header.pointer_size not in (4, 8):
+            raise ValueError(f"Unsupported pointer size {header.pointer_size}")
+        if header.event_size != struct.calcsize(header.event_format()):
+            raise ValueError(f"Unsupported event size {header.event_size}")
+        return header
+
+    def as_bytes(self) -> bytes:
+        return struct.pack(
+            self.FORMAT,
+            self.MAGIC,
+            self.VERSION,
+            self.core_count,
+            self.event_size,
+            self.pointer_size,
+            self.cycles_per_us,
+            self.dropped,
+        )
+
+    def event_format(self) -> str:
+        # FuriHalProfileEvent, context is uintptr_t
+        return "<IHBBQ" if self.pointer_size == 8 else "<IHBBI"
+
+
+@dataclass
+class ZoneSpan:
+    zone_id: int
+    core: int
+    context: int
+    begin: int
+    end: int
+
+    @property
+    def duration(self) -> int:
+        return self.end - self.begin
+
+
+class ProfileDecoder:
+    """Pairs begin/end events per (core, context), unwrapping 32-bit cycle counter
+
+    Counter is per core, so unwrapping is per core too. Nesting holds only
+    within one context: a thread zone preempted by another thread's or
+    ISR's zone ends after it.
+    """
+
+    TYPE_BEGIN = 0
+    TYPE_END = 1
+
+    def __init__(self, header: ProfileHeader):
+        self.header = header
+        self.spans: list[ZoneSpan] = []
+        self.unmatched = 0
+        self._stacks = defaultdict(list)
+        self._last_raw = {}
+        self._epoch = defaultdict(int)
+
+    def _unwrap(self, core: int, cycles: int) -> int:
+        last = self._last_raw.get(core)
+        if last is not None and cycles < last:
+            self._epoch[core] += 1 << 32
+        self._last_raw[core] = cycles
+        return self._epoch[core] + cycles
+
+    def feed(self, payload: bytes):
+        for cycles, zone_id, event_type, core, context in struct.iter_unpack(
+            self.header.event_format(), payload
+        ):
+            timestamp = self._unwrap(core, cycles)
+            stack = self._stacks[core, context]
+            if event_type == self.TYPE_BEGIN:
+                stack.append((zone_id, timestamp))
+                continue
+
+            if not any(open_zone_id == zone_id for open_zone_id, _ in stack):
+                self.unmatched += 1
+                continue
+            # Zones are strictly nested, so unwind to matching begin
+            while stack[-1][0] != zone_id:
+                stack.pop()
+                self.unmatched += 1
+            _, begin = stack.pop()
+            self.spans.append(ZoneSpan(zone_id, core, context, begin, timestamp))
+        return self
+
+    @property
+    def open_zones(self) -> int:
+        return sum(len(stack) for stack in self._stacks.values())
+
+
+def percentile(sorted_values: list[int], p: float) -> int:
+    index = max(math.ceil(p / 100 * len(sorted_values)) - 1, 0)
+    return sorted_values[index]
+
+
+def load_zone_names(path: str | None) -> dict[int, str]:
+    names = {}
+    if not path:
+        return names
+    with open(path, "r") as f:
+        for line in f:
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            zone_id, name = line.replace("=", " ").split(None, 1)
+            names[int(zone_id, 0)] = name.strip()
+    return names
+
+
+class Main(App):
+    CLI_DRAIN_COMMAND = "profile drain"
+
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_capture = self.subparsers.add_parser(
+            "capture", help="Drain profile ring buffers over CLI"
+        )
+        self.parser_capture.add_argument(
+            "-p", "--port", help="CDC Port", default="auto"
+        )
+        self.parser_capture.add_argument("output", help="Output stream file")
+        self.parser_capture.set_defaults(func=self.capture)
+
+        self.parser_stats = self.subparsers.add_parser(
+            "stats", help="Per-zone latency table"
+        )
+        self._add_common_args(self.parser_stats)
+        self.parser_stats.add_argument(
+            "--cycles", action="store_true", help="Report cycles instead of us"
+        )
+        self.parser_stats.set_defaults(func=self.stats)
+
+        self.parser_chrome = self.subparsers.add_parser(
+            "chrome", help="Chrome trace JSON (chrome://tracing, Perfetto)"
+        )
+        self._add_common_args(self.parser_chrome)
+        self.parser_chrome.add_argument("output", help="Output JSON file")
+        self.parser_chrome.set_defaults(func=self.chrome)
+
+    def _add_common_args(self, parser):
+        parser.add_argument("stream", help="Profile stream file")
+        parser.add_argument(
+            "-n",
+            "--names",
+            help="Zone names file, one 'id name' pair per line",
+        )
+
+    def _decode(self):
+        with open(self.args.stream, "rb") as f:
+            data = f.read()
+        header = ProfileHeader.from_bytes(data)
+        decoder = ProfileDecoder(header).feed(data[ProfileHeader.SIZE :])
+        self.logger.info(f"Decoded {len(decoder.spans)} zone spans")
+        if header.dropped:
+            self.logger.warning(f"{header.dropped} events were dropped on overflow")
+        if decoder.unmatched or decoder.open_zones:
+            self.logger.warning(
+                f"Unpaired events: {decoder.unmatched}, open zones: {decoder.open_zones}"
+            )
+        self.zone_names = load_zone_names(self.args.names)
+        return header, decoder
+
+    @staticmethod
+    def _context_name(context: int) -> str:
+        if context < ProfileHeader.CONTEXT_ISR_LIMIT:
+            return f"isr {context}"
+        return f"thread 0x{context:08x}"
+
+    def _zone_name(self, zone_id: int) -> str:
+        return self.zone_names.get(zone_id, f"zone_{zone_id}")
+
+    def capture(self):
+        # Serial dependencies are only needed for capture
+        from flipper.storage import FlipperStorage
+        from flipper.utils.cdc import resolve_port
+        from flipper.utils.clidrain import CliDrainError, cli_drain
+
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+
+        try:
+            with FlipperStorage(port) as cli:
+                data = cli_drain(cli, self.CLI_DRAIN_COMMAND)
+        except CliDrainError as e:
+            self.logger.error(f"Capture failed: {e}")
+            return 1
+        ProfileHeader.from_bytes(data)
+
+        with open(self.args.output, "wb") as f:
+            f.write(data)
+        self.logger.info(f"Captured {len(data)} bytes to {self.args.output}")
+        return 0
+
+    def stats(self):
+        header, decoder = self._decode()
+        if self.args.cycles or not header.cycles_per_us:
+            scale, unit = 1, "cyc"
+        else:
+            scale, unit = header.cycles_per_us, "us"
+
+        by_zone = defaultdict(list)
+        for span in decoder.spans:
+            by_zone[span.zone_id].append(span.duration)
+
+        print(
+            f"{'zone':<24} {'count':>8} {'min':>10} {'avg':>10} {'p99':>10} {'max':>10} {'total':>12} ({unit})"
+        )
+        for zone_id, durations in sorted(
+            by_zone.items(), key=lambda item: sum(item[1]), reverse=True
+        ):
+            durations.sort()
+            values = (
+                durations[0],
+                sum(durations) / len(durations),
+                percentile(durations, 99),
+                durations[-1],
+            )
+            print(
+                f"{self._zone_name(zone_id):<24} {len(durations):>8} "
+                + " ".join(f"{v / scale:>10.2f}" for v in values)
+                + f" {sum(durations) / scale:>12.2f}"
+            )
+        return 0
+
+    def chrome(self):
+        header, decoder = self._decode()
+        scale = header.cycles_per_us or 1
+        origin = min((span.begin for span in decoder.spans), default=0)
+
+        trace_events = [
+            {
+                "name": self._zone_name(span.zone_id),
+                "cat": "zone",
+                "ph": "X",
+                "ts": (span.begin - origin) / scale,
+                "dur": span.duration / scale,
+                "pid": span.core,
+                "tid": self._context_name(span.context),
+                "args": {"cycles": span.duration},
+            }
+            for span in decoder.spans
+        ]
+        with open(self.args.output, "w") as f:
+            json.dump({"traceEvents": trace_events, "displayTimeUnit": "ns"}, f)
+        self.logger.info(f"Wrote {len(trace_events)} events to {self.args.output}")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -16,9 +16,11 @@ struct STOP_EXTERNING_ME {};
 #include <furi_hal_memory.h>
 #include <furi_hal_debug.h>
 #include <furi_hal_interrupt.h>
+#include <furi_hal_deferred.h>
 #include <furi_hal_os.h>
 #include <furi_hal_cortex.h>
 #include <furi_hal_bus.h>
+#include <furi_hal_profile.h>
 #include <furi_hal_target.h>
 
 #ifdef __cplusplus
@@ -0,0 +1,107 @@
+/**
+ * @file furi_hal_bench.h
+ * Benchmark harness
+ *
+ * Benchmarks are apps declared with apptype=FlipperAppType.BENCHMARK. Their
+ * entry point runs a table of cases with furi_hal_bench_run(), which writes
+ * one result line per sample:
+ *
+ *     bench <case> <iterations> <elapsed_ns>
+ *
+ * and `bench-done <case_count>` when finished. On device time is measured
+ * with the same cycle counter as FuriHalCortexTimer and lines go to
+ * FURI_HAL_BENCH_OUTPUT_PATH. On host targets a monotonic clock is used and
+ * lines go to stdout.
+ *
+ * `./fbt bench` builds and runs benchmarks, results are collected with
+ * `scripts/fwbench.py`.
+ *
+ * Not part of furi_hal.h, benchmark apps include it directly.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Result file on device, truncated on every furi_hal_bench_run() */
+#define FURI_HAL_BENCH_OUTPUT_PATH "/ext/.bench.txt"
+
+/** Default number of recorded samples per case */
+#define FURI_HAL_BENCH_DEFAULT_SAMPLES (16U)
+
+/** Default minimal sample duration, iterations are calibrated to reach it */
+#define FURI_HAL_BENCH_DEFAULT_SAMPLE_US (10000U)
+
+/** Benchmark timer, opaque start timestamp */
+typedef struct {
+    uint64_t start;
+} FuriHalBenchTimer;
+
+/** Benchmark case body
+ *
+ * Must run measured code `iterations` times.
+ *
+ * @param      context     The context returned by setup, or NULL
+ * @param[in]  iterations  The iterations count
+ */
+typedef void (*FuriHalBenchCallback)(void* context, uint32_t iterations);
+
+/** Benchmark case */
+typedef struct {
+    const char* name; /**< Case name, no spaces */
+    FuriHalBenchCallback callback; /**< Measured body */
+    void* (*setup)(void); /**< Optional, called before calibration, not measured */
+    void (*teardown)(void* context); /**< Optional, called after last sample */
+} FuriHalBenchCase;
+
+/** Benchmark run configuration, zero fields mean defaults */
+typedef struct {
+    uint32_t samples; /**< Recorded samples per case */
+    uint32_t sample_us; /**< Minimal sample duration */
+} FuriHalBenchConfig;
+
+/** Start benchmark timer
+ *
+ * @return     The FuriHalBenchTimer
+ */
+FuriHalBenchTimer furi_hal_bench_timer_start(void);
+
+/** Get time elapsed since timer start
+ *
+ * Device cycle counter is 32 bit: single measurement must be shorter than
+ * its wrap period, which furi_hal_bench_run() guarantees by calibration.
+ *
+ * @param[in]  timer  The FuriHalBenchTimer
+ *
+ * @return     elapsed time in nanoseconds
+ */
+uint64_t furi_hal_bench_timer_elapsed_ns(FuriHalBenchTimer timer);
+
+/** Run benchmark cases and write result lines
+ *
+ * Each case is calibrated by doubling iterations until a sample lasts at
+ * least config->sample_us, then one warm-up and config->samples recorded
+ * samples are run.
+ *
+ * @param[in]  cases   The cases
+ * @param[in]  count   The cases count
+ * @param[in]  config  The configuration, NULL for defaults
+ *
+ * @return     0 on success, negative if output can't be written
+ */
+int32_t furi_hal_bench_run(
+    const FuriHalBenchCase* cases,
+    size_t count,
+    const FuriHalBenchConfig* config);
+
+/** Keep value alive, so measured computation is not optimized out */
+#define FURI_HAL_BENCH_KEEP(value) __asm__ volatile("" : : "r"(value) : "memory")
+
+#ifdef __cplusplus
+}
+#endif
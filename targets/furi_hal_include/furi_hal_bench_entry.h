@@ -0,0 +1,30 @@
+/**
+ * @file furi_hal_bench_entry.h
+ * Benchmark host program entry
+ *
+ * Only for host target harness. Symbol is not defined by firmware: fbt
+ * aliases it to the benchmark manifest entry_point with --defsym when
+ * linking each benchmark program, so it must stay out of SDK headers.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Host program entry
+ *
+ * Host harness main() calls it. Device builds start entry_point as an app.
+ *
+ * @param      p     Always NULL
+ *
+ * @return     exit code
+ */
+int32_t furi_hal_bench_entry(void* p);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file furi_hal_deferred.h
+ * ISR-to-thread deferred work HAL API
+ *
+ * Deferred queue moves fixed size items from interrupt handlers to a worker
+ * thread through a lock-free ring buffer. Posting never blocks and uses no
+ * OS primitives, so it is allowed from any interrupt priority including
+ * FuriHalInterruptPriorityKamiSama. Worker is woken up through a pended
+ * lowest priority software interrupt and drains items in batches.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriHalDeferredQueue FuriHalDeferredQueue;
+
+typedef enum {
+    FuriHalDeferredModeSpsc, /**< Single producer: one ISR posts, cheapest post */
+    FuriHalDeferredModeMpsc, /**< Multiple producers: ISRs of any priority may post */
+} FuriHalDeferredMode;
+
+/** Deferred work callback, called from worker thread
+ *
+ * @param      items    Pointer to first item of the batch
+ * @param      count    Number of items in the batch, contiguous in memory
+ * @param      context  Callback context
+ */
+typedef void (*FuriHalDeferredCallback)(const void* items, size_t count, void* context);
+
+/** Deferred queue statistics */
+typedef struct {
+    uint32_t posted; /**< Items accepted */
+    uint32_t overflow; /**< Items rejected because ring was full */
+    uint32_t batches; /**< Callback invocations */
+    uint32_t max_batch; /**< Largest batch delivered to callback */
+    uint32_t max_fill; /**< Ring fill level high watermark */
+} FuriHalDeferredStats;
+
+/** Initialize deferred work subsystem, starts worker thread */
+void furi_hal_deferred_init(void);
+
+/** Allocate deferred queue
+ *
+ * @param[in]  mode       Producer mode
+ * @param[in]  item_size  Item size in bytes
+ * @param[in]  capacity   Number of items, must be power of 2
+ * @param[in]  callback   Callback to handle items in worker thread
+ * @param      context    Callback context
+ *
+ * @return     Pointer to FuriHalDeferredQueue
+ */
+FuriHalDeferredQueue* furi_hal_deferred_queue_alloc(
+    FuriHalDeferredMode mode,
+    size_t item_size,
+    size_t capacity,
+    FuriHalDeferredCallback callback,
+    void* context);
+
+/** Free deferred queue
+ *
+ * @warning    Ensure that no ISR posts to the queue anymore.
+ *
+ * @param      queue  Pointer to FuriHalDeferredQueue
+ */
+void furi_hal_deferred_queue_free(FuriHalDeferredQueue* queue);
+
+/** Post item to deferred queue
+ *
+ * Safe to call from any context. Item is copied into the ring.
+ *
+ * @param      queue  Pointer to FuriHalDeferredQueue
+ * @param[in]  item   Pointer to item of item_size bytes
+ *
+ * @return     true if posted, false if ring was full and item was dropped
+ */
+bool furi_hal_deferred_post(FuriHalDeferredQueue* queue, const void* item);
+
+/** Drain deferred queue in the calling thread
+ *
+ * Delivers all pending items to the callback. Normally done by the worker
+ * thread, useful for polling and shutdown paths.
+ *
+ * @param      queue  Pointer to FuriHalDeferredQueue
+ *
+ * @return     Number of items delivered
+ */
+size_t furi_hal_deferred_drain(FuriHalDeferredQueue* queue);
+
+/** Get deferred queue statistics
+ *
+ * @param      queue  Pointer to FuriHalDeferredQueue
+ * @param[out] stats  Pointer to FuriHalDeferredStats
+ */
+void furi_hal_deferred_get_stats(FuriHalDeferredQueue* queue, FuriHalDeferredStats* stats);
+
+/** Reset deferred queue statistics
+ *
+ * @param      queue  Pointer to FuriHalDeferredQueue
+ */
+void furi_hal_deferred_reset_stats(FuriHalDeferredQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
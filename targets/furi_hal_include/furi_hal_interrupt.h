@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include <furi_hal_interrupt_defs.h>
 
@@ -76,6 +77,70 @@ const char* furi_hal_interrupt_get_name(uint8_t exception_number);
  */
 uint32_t furi_hal_interrupt_get_time_in_isr_total(void);
 
+/** Interrupt statistics stream magic, "IRQS" */
+#define FURI_HAL_INTERRUPT_STATS_MAGIC (0x53515249UL)
+
+/** Interrupt statistics stream format version */
+#define FURI_HAL_INTERRUPT_STATS_VERSION (2U)
+
+/** Number of log2 buckets in ISR duration histogram */
+#define FURI_HAL_INTERRUPT_STATS_HISTOGRAM_SIZE (16U)
+
+/** Interrupt statistics stream header
+ *
+ * Stream is the header, record_count FuriHalInterruptStats records and a
+ * name table: one NUL-terminated furi_hal_interrupt_get_name() string per
+ * record in the same order, empty if the name is unknown.
+ */
+typedef struct {
+    uint32_t magic; /**< FURI_HAL_INTERRUPT_STATS_MAGIC */
+    uint8_t version; /**< FURI_HAL_INTERRUPT_STATS_VERSION */
+    uint8_t histogram_size; /**< FURI_HAL_INTERRUPT_STATS_HISTOGRAM_SIZE */
+    uint16_t record_size; /**< sizeof(FuriHalInterruptStats) */
+    uint32_t cycles_per_us; /**< furi_hal_cortex_instructions_per_microsecond() */
+    uint32_t elapsed_ms; /**< Time since last furi_hal_interrupt_reset_stats */
+    uint16_t record_count; /**< Records following the header */
+    uint16_t names_size; /**< Name table size, bytes */
+} FuriHalInterruptStatsHeader;
+
+/** Per-interrupt time accounting
+ *
+ * Histogram bucket N counts ISR runs that took [2^N, 2^(N+1)) CPU clocks,
+ * last bucket also counts everything longer.
+ */
+typedef struct {
+    uint64_t cycles_total; /**< Total time in ISR, CPU clocks */
+    uint32_t count; /**< Number of ISR invocations */
+    uint32_t cycles_max; /**< Longest ISR run, CPU clocks */
+    uint8_t exception_number; /**< Use with furi_hal_interrupt_get_name */
+    uint8_t reserved[3];
+    uint32_t histogram[FURI_HAL_INTERRUPT_STATS_HISTOGRAM_SIZE];
+} FuriHalInterruptStats;
+
+/** Get per-interrupt statistics snapshot
+ *
+ * Statistics are collected only when firmware is built with
+ * FURI_HAL_INTERRUPT_STATS defined, otherwise ISR dispatch is unchanged.
+ *
+ * @param[in]  index  - interrupt ID
+ * @param[out] stats  - pointer to FuriHalInterruptStats
+ *
+ * @return     true if statistics are available
+ */
+bool furi_hal_interrupt_get_stats(FuriHalInterruptId index, FuriHalInterruptStats* stats);
+
+/** Fill interrupt statistics stream header
+ *
+ * record_count and names_size are left zero, they are set by the stream
+ * writer, `irq_stats` CLI command.
+ *
+ * @param[out] header  - pointer to FuriHalInterruptStatsHeader
+ */
+void furi_hal_interrupt_get_stats_header(FuriHalInterruptStatsHeader* header);
+
+/** Reset per-interrupt statistics */
+void furi_hal_interrupt_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
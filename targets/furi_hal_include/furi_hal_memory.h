@@ -81,6 +81,76 @@ void furi_hal_memory_set_heap_track_mode(FuriHalMemoryHeapTrackMode mode);
  */
 FuriHalMemoryHeapTrackMode furi_hal_memory_get_heap_track_mode(void);
 
+/** Heap trace stream magic, "HTRC" */
+#define FURI_HAL_MEMORY_HEAP_TRACE_MAGIC (0x43525448UL)
+
+/** Heap trace stream format version */
+#define FURI_HAL_MEMORY_HEAP_TRACE_VERSION (1U)
+
+typedef enum {
+    FuriHalMemoryHeapTraceEventTypeAlloc = 1, /**< Block allocated */
+    FuriHalMemoryHeapTraceEventTypeFree = 2, /**< Block freed */
+} FuriHalMemoryHeapTraceEventType;
+
+/** Heap trace stream header, emitted once before drained events */
+typedef struct {
+    uint32_t magic; /**< FURI_HAL_MEMORY_HEAP_TRACE_MAGIC */
+    uint8_t version; /**< FURI_HAL_MEMORY_HEAP_TRACE_VERSION */
+    uint8_t pointer_size; /**< sizeof(uintptr_t) of the producer */
+    uint16_t event_size; /**< sizeof(FuriHalMemoryHeapTraceEvent) */
+    uint32_t tick_frequency; /**< Tick frequency in Hz */
+    uint32_t dropped; /**< Events lost to ring buffer overflow since last drain */
+} FuriHalMemoryHeapTraceHeader;
+
+/** Heap trace event, recorded for tracked threads only */
+typedef struct {
+    uint8_t type; /**< One of FuriHalMemoryHeapTraceEventType */
+    uint8_t reserved[3];
+    uint32_t tick; /**< OS tick of the event */
+    uint32_t size; /**< Requested size, 0 for free */
+    uintptr_t pointer; /**< Block address */
+    uintptr_t caller; /**< Return address of the malloc/free caller */
+    uintptr_t thread; /**< FuriThreadId of the calling thread */
+} FuriHalMemoryHeapTraceEvent;
+
+/** Record heap trace event
+ *
+ * Called by the heap implementation for every allocation and free made while
+ * the current thread is tracked according to FuriHalMemoryHeapTrackMode.
+ * Events are stored in a ring buffer, oldest events are overwritten on
+ * overflow and counted as dropped.
+ *
+ * @param[in]  type     The event type
+ * @param[in]  pointer  The block address
+ * @param[in]  size     The requested size, 0 for free
+ * @param[in]  caller   The caller return address
+ */
+void furi_hal_memory_heap_trace_record(
+    FuriHalMemoryHeapTraceEventType type,
+    void* pointer,
+    size_t size,
+    void* caller);
+
+/** Fill heap trace stream header
+ *
+ * Dropped counter is reset by this call.
+ *
+ * @param[out] header  Pointer to FuriHalMemoryHeapTraceHeader
+ */
+void furi_hal_memory_heap_trace_get_header(FuriHalMemoryHeapTraceHeader* header);
+
+/** Drain heap trace events from ring buffer
+ *
+ * @param[out] events  Buffer for events
+ * @param[in]  count   Buffer capacity in events
+ *
+ * @return     Number of events moved to the buffer
+ */
+size_t furi_hal_memory_heap_trace_drain(FuriHalMemoryHeapTraceEvent* events, size_t count);
+
+/** Discard all recorded heap trace events */
+void furi_hal_memory_heap_trace_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,141 @@
+/**
+ * @file furi_hal_profile.h
+ * Cycle-count profiling zones
+ *
+ * Zones record begin/end cycle counts (same counter as FuriHalCortexTimer)
+ * with a static zone ID into a lock-free per-core ring buffer. Recording is
+ * compiled in only when FURI_HAL_PROFILE is defined, i.e. with
+ * `./fbt --extra-define=FURI_HAL_PROFILE`. Otherwise all zone macros expand
+ * to nothing.
+ *
+ * Drained buffer can be decoded with `scripts/profzone.py`.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Profile stream magic, "PROF" */
+#define FURI_HAL_PROFILE_MAGIC (0x464F5250UL)
+
+/** Profile stream format version */
+#define FURI_HAL_PROFILE_VERSION (3U)
+
+/** Event contexts below this value are exception numbers (IPSR) */
+#define FURI_HAL_PROFILE_CONTEXT_ISR_LIMIT (0x200UL)
+
+typedef enum {
+    FuriHalProfileEventTypeBegin = 0, /**< Zone entered */
+    FuriHalProfileEventTypeEnd = 1, /**< Zone left */
+} FuriHalProfileEventType;
+
+/** Profile stream header, emitted once before drained events */
+typedef struct {
+    uint32_t magic; /**< FURI_HAL_PROFILE_MAGIC */
+    uint8_t version; /**< FURI_HAL_PROFILE_VERSION */
+    uint8_t core_count; /**< Number of per-core buffers */
+    uint16_t event_size; /**< sizeof(FuriHalProfileEvent) */
+    uint8_t pointer_size; /**< sizeof(uintptr_t) of the producer */
+    uint8_t reserved[3];
+    uint32_t cycles_per_us; /**< furi_hal_cortex_instructions_per_microsecond() */
+    uint32_t dropped; /**< Events lost to ring buffer overflow since last drain */
+} FuriHalProfileHeader;
+
+/** Profile event
+ *
+ * Zones of different contexts interleave when one preempts another, so
+ * begin/end events are paired per (core, context).
+ */
+typedef struct {
+    uint32_t cycles; /**< Cycle counter value */
+    uint16_t zone_id; /**< Static zone ID */
+    uint8_t type; /**< One of FuriHalProfileEventType */
+    uint8_t core; /**< Core that recorded the event */
+    uintptr_t context; /**< IPSR exception number in ISR, FuriThreadId otherwise */
+} FuriHalProfileEvent;
+
+/** Profile zone handle, used by scoped zones */
+typedef struct {
+    uint16_t zone_id;
+} FuriHalProfileZone;
+
+/** Record profile event
+ *
+ * Safe to call from any context, including ISR of any priority. Slot in the
+ * current core ring buffer is reserved with a single atomic increment, events
+ * are dropped and counted when buffer is full.
+ *
+ * @param[in]  zone_id  The zone ID
+ * @param[in]  type     The event type
+ */
+void furi_hal_profile_record(uint16_t zone_id, FuriHalProfileEventType type);
+
+/** Fill profile stream header
+ *
+ * Dropped counter is reset by this call.
+ *
+ * @param[out] header  Pointer to FuriHalProfileHeader
+ */
+void furi_hal_profile_get_header(FuriHalProfileHeader* header);
+
+/** Drain profile events from all per-core ring buffers
+ *
+ * @param[out] events  Buffer for events
+ * @param[in]  count   Buffer capacity in events
+ *
+ * @return     Number of events moved to the buffer
+ */
+size_t furi_hal_profile_drain(FuriHalProfileEvent* events, size_t count);
+
+/** Discard all recorded profile events */
+void furi_hal_profile_reset(void);
+
+static inline FuriHalProfileZone furi_hal_profile_zone_enter(uint16_t zone_id) {
+    furi_hal_profile_record(zone_id, FuriHalProfileEventTypeBegin);
+    FuriHalProfileZone zone = {zone_id};
+    return zone;
+}
+
+static inline void furi_hal_profile_zone_leave(FuriHalProfileZone* zone) {
+    furi_hal_profile_record(zone->zone_id, FuriHalProfileEventTypeEnd);
+}
+
+#ifdef FURI_HAL_PROFILE
+
+#define FURI_HAL_PROFILE_CONCAT_(a, b) a##b
+#define FURI_HAL_PROFILE_CONCAT(a, b)  FURI_HAL_PROFILE_CONCAT_(a, b)
+
+/** Profile enclosing scope, zone ends when scope is left */
+#define FURI_HAL_PROFILE_ZONE(zone_id)                                                   \
+    FuriHalProfileZone FURI_HAL_PROFILE_CONCAT(__furi_hal_profile_zone_, __LINE__)       \
+        __attribute__((cleanup(furi_hal_profile_zone_leave), unused)) =                  \
+            furi_hal_profile_zone_enter(zone_id)
+
+/** Begin zone explicitly, must be paired with FURI_HAL_PROFILE_END */
+#define FURI_HAL_PROFILE_BEGIN(zone_id) \
+    furi_hal_profile_record((zone_id), FuriHalProfileEventTypeBegin)
+
+/** End zone started with FURI_HAL_PROFILE_BEGIN */
+#define FURI_HAL_PROFILE_END(zone_id) \
+    furi_hal_profile_record((zone_id), FuriHalProfileEventTypeEnd)
+
+#else
+
+#define FURI_HAL_PROFILE_ZONE(zone_id)
+#define FURI_HAL_PROFILE_BEGIN(zone_id) \
+    do {                                \
+    } while(0)
+#define FURI_HAL_PROFILE_END(zone_id) \
+    do {                              \
+    } while(0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -79,6 +79,103 @@ typedef void (*FuriHalRtcAlarmCallback)(void* context);
  */
 void furi_hal_rtc_set_alarm_callback(FuriHalRtcAlarmCallback callback, void* context);
 
+/** Get UNIX Timestamp with millisecond resolution
+ *
+ * Date part is cached and refreshed on second rollover, so the call only
+ * reads RTC sub-second and time registers.
+ *
+ * @warning    This is wall-clock time: it jumps when date and time are set.
+ *             Use furi_hal_rtc_get_monotonic_ms for intervals.
+ *
+ * @return     Milliseconds from UNIX epoch start
+ */
+uint64_t furi_hal_rtc_get_timestamp_ms(void);
+
+/** Get monotonic milliseconds
+ *
+ * Derived from the same RTC registers as furi_hal_rtc_get_timestamp_ms,
+ * furi_hal_rtc_set_datetime compensates the change with an internal
+ * offset, so the value never jumps and never goes backwards. Counts in
+ * sleep and stop modes, origin is unspecified.
+ *
+ * @return     Monotonic milliseconds
+ */
+uint64_t furi_hal_rtc_get_monotonic_ms(void);
+
+/** RTC timer wheel slot width in microseconds
+ *
+ * Wheel is driven by the hardware alarm with sub-second match at 1/256 s
+ * granularity. Timers never fire early and fire at most one slot late.
+ */
+#define FURI_HAL_RTC_TIMER_RESOLUTION_US (3906U)
+
+/** RTC timer
+ *
+ * Storage is owned by the caller, fields are private to the timer wheel.
+ */
+typedef struct FuriHalRtcTimer FuriHalRtcTimer;
+struct FuriHalRtcTimer {
+    FuriHalRtcTimer* next;
+    FuriHalRtcTimer* prev;
+    uint64_t expire; /**< furi_hal_rtc_get_monotonic_ms timeline */
+    FuriHalRtcAlarmCallback callback;
+    void* context;
+};
+
+/** Initialize RTC timer
+ *
+ * @param      timer     Pointer to FuriHalRtcTimer
+ * @param[in]  callback  The callback, delivered from RTC alarm ISR
+ * @param      context   The context
+ */
+void furi_hal_rtc_timer_init(
+    FuriHalRtcTimer* timer,
+    FuriHalRtcAlarmCallback callback,
+    void* context);
+
+/** Schedule RTC timer
+ *
+ * Timers are kept in a hierarchical timer wheel multiplexed over the
+ * hardware alarm, start and stop are O(1). Restarting running timer
+ * reschedules it. Timers expiring in the past fire on next alarm ISR.
+ *
+ * Expiry is on the monotonic timeline: furi_hal_rtc_set_datetime does not
+ * shift scheduled timers. The wheel reprograms the hardware alarm after
+ * the date is set, as the alarm compares against wall-clock registers.
+ * Resolution is FURI_HAL_RTC_TIMER_RESOLUTION_US.
+ *
+ * @warning    Timer wheel owns the hardware alarm while any timer is
+ *             scheduled, do not use furi_hal_rtc_set_alarm at the same time.
+ *
+ * @param      timer       Pointer to FuriHalRtcTimer
+ * @param[in]  timeout_ms  Delay from now, in milliseconds
+ */
+void furi_hal_rtc_timer_start(FuriHalRtcTimer* timer, uint32_t timeout_ms);
+
+/** Schedule RTC timer at absolute monotonic time
+ *
+ * Same as furi_hal_rtc_timer_start, for periodic timers that must not
+ * accumulate drift.
+ *
+ * @param      timer         Pointer to FuriHalRtcTimer
+ * @param[in]  monotonic_ms  furi_hal_rtc_get_monotonic_ms value to fire at
+ */
+void furi_hal_rtc_timer_start_at(FuriHalRtcTimer* timer, uint64_t monotonic_ms);
+
+/** Cancel RTC timer, no-op if timer is not scheduled
+ *
+ * @param      timer  Pointer to FuriHalRtcTimer
+ */
+void furi_hal_rtc_timer_stop(FuriHalRtcTimer* timer);
+
+/** Check if RTC timer is scheduled
+ *
+ * @param      timer  Pointer to FuriHalRtcTimer
+ *
+ * @return     true if scheduled
+ */
+bool furi_hal_rtc_timer_is_running(const FuriHalRtcTimer* timer);
+
 #ifdef __cplusplus
 }
 #endif